@@ -20,7 +20,7 @@ limitations under the License.
 // INCLUDE LIBRARIES
 
 #include "ConsoleInput.hpp"
-#include "../history/HistoryManager.hpp"
+#include "../headers/Console.hpp"
 
 namespace Console
 {
@@ -102,6 +102,17 @@ namespace Console
      */
     void Input::handleKeyEvent(const KEY_EVENT_RECORD &key)
     {
+        const bool ctrl = (key.dwControlKeyState & (LEFT_CTRL_PRESSED | RIGHT_CTRL_PRESSED)) != 0;
+
+        if (m_searching && !handleSearchKey(key))
+            return;
+
+        if (ctrl && key.wVirtualKeyCode == 'R')
+        {
+            startSearch();
+            return;
+        }
+
         switch (key.wVirtualKeyCode)
         {
         case VK_BACK:
@@ -227,6 +238,177 @@ namespace Console
         redrawLine();
     }
 
+    /**
+     * @brief Enters reverse incremental search mode (Ctrl+R).
+     */
+    void Input::startSearch()
+    {
+        m_searching = true;
+        m_searchFailed = false;
+        m_query.clear();
+        m_match.reset();
+        m_beforeSearch = m_buffer;
+
+        redrawSearch();
+    }
+
+    /**
+     * @brief Handles a key during Ctrl+R search.
+     *
+     * @param key Windows KEY_EVENT_RECORD describing the key event.
+     * @return true if the search ended and the key must be handled normally.
+     */
+    bool Input::handleSearchKey(const KEY_EVENT_RECORD &key)
+    {
+        const bool ctrl = (key.dwControlKeyState & (LEFT_CTRL_PRESSED | RIGHT_CTRL_PRESSED)) != 0;
+
+        switch (key.wVirtualKeyCode)
+        {
+        case 'R':
+            if (!ctrl)
+                break;
+
+            // Next match for the same query
+            if (m_match)
+                search(m_rank + 1);
+            redrawSearch();
+            return false;
+
+        case 'G':
+            if (!ctrl)
+                break;
+
+            endSearch(false);
+            return false;
+
+        case VK_ESCAPE:
+            endSearch(false);
+            return false;
+
+        case VK_BACK:
+            if (!m_query.empty())
+            {
+                m_query.pop_back();
+                m_match.reset();
+                search(0);
+            }
+            redrawSearch();
+            return false;
+
+        case VK_RETURN:
+            endSearch(true);
+            return false; // readLine() returns the accepted line
+
+        case VK_LEFT:
+        case VK_RIGHT:
+        case VK_UP:
+        case VK_DOWN:
+            endSearch(true);
+            return true; // edit or navigate from the match
+        }
+
+        if (key.uChar.UnicodeChar >= L' ')
+        {
+            m_query += key.uChar.UnicodeChar;
+            search(0);
+            redrawSearch();
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Looks up the match of the query at `rank`.
+     *
+     * @param rank 0 for the best match by frecency, 1 for the next, and so on.
+     */
+    void Input::search(size_t rank)
+    {
+        if (m_query.empty())
+        {
+            m_searchFailed = false;
+            return;
+        }
+
+        auto found = m_history.search(m_query, rank);
+        m_searchFailed = !found;
+
+        if (found)
+        {
+            m_match = std::move(found);
+            m_rank = rank;
+        }
+    }
+
+    /**
+     * @brief Leaves search mode.
+     *
+     * @param accept Keep the match as the input line; otherwise restore the line.
+     */
+    void Input::endSearch(bool accept)
+    {
+        m_searching = false;
+
+        if (accept && m_match)
+            m_buffer = m_match->command;
+        else if (!accept)
+            m_buffer = m_beforeSearch;
+
+        m_cursor = m_buffer.size();
+        m_history.resetNavigation();
+        redrawLine();
+    }
+
+    /**
+     * @brief Draws "(reverse-i-search)'query': command" with the match highlighted.
+     *
+     * The cursor is left at the start of the matched text.
+     */
+    void Input::redrawSearch()
+    {
+        CONSOLE_SCREEN_BUFFER_INFO info{};
+        GetConsoleScreenBufferInfo(m_stdout, &info);
+
+        COORD start = info.dwCursorPosition;
+        start.X = m_promptStartX;
+
+        SetConsoleCursorPosition(m_stdout, start);
+
+        DWORD written;
+        std::wstring clear(info.dwSize.X - m_promptStartX, L' ');
+        WriteConsoleW(m_stdout, clear.c_str(), static_cast<DWORD>(clear.size()), &written, nullptr);
+        SetConsoleCursorPosition(m_stdout, start);
+
+        const std::wstring label = (m_searchFailed ? L"(failed reverse-i-search)'" : L"(reverse-i-search)'") + m_query + L"': ";
+
+        console::setColor(ConsoleColor::Gray);
+        WriteConsoleW(m_stdout, label.c_str(), static_cast<DWORD>(label.size()), &written, nullptr);
+        console::reset();
+
+        size_t cursor = label.size();
+
+        if (m_match)
+        {
+            const std::wstring &command = m_match->command;
+            const std::wstring before = command.substr(0, m_match->start);
+            const std::wstring matched = command.substr(m_match->start, m_match->length);
+            const std::wstring after = command.substr(m_match->start + m_match->length);
+
+            WriteConsoleW(m_stdout, before.c_str(), static_cast<DWORD>(before.size()), &written, nullptr);
+
+            console::setColor(ConsoleColor::Yellow);
+            WriteConsoleW(m_stdout, matched.c_str(), static_cast<DWORD>(matched.size()), &written, nullptr);
+            console::reset();
+
+            WriteConsoleW(m_stdout, after.c_str(), static_cast<DWORD>(after.size()), &written, nullptr);
+
+            cursor += before.size();
+        }
+
+        start.X = m_promptStartX + static_cast<SHORT>(cursor);
+        SetConsoleCursorPosition(m_stdout, start);
+    }
+
     /**
      * @brief Redraws the entire input line on the console.
      *
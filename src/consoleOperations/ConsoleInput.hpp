@@ -22,13 +22,12 @@ limitations under the License.
 // INCLUDE LIBRARIES
 
 #include <string>
+#include <optional>
 
 #include <windows.h>
 
-namespace History
-{
-    class Manager;
-}
+#include "../history/HistoryManager.hpp"
+
 namespace Console
 {
     class Input
@@ -118,6 +117,42 @@ namespace Console
          */
         void arrowLeft();
 
+        /**
+         * @brief Starts a reverse incremental history search (Ctrl+R).
+         *
+         * Typed characters extend the query and show the best matching
+         * command by frecency; Ctrl+R again shows the next one. Enter runs the match,
+         * arrow keys take it for editing, Esc or Ctrl+G restore the line.
+         */
+        void startSearch();
+
+        /**
+         * @brief Handles a key while a history search is active.
+         *
+         * @param key The KEY_EVENT_RECORD describing the key event.
+         * @return true if the search ended and the key still has to be handled as usual.
+         */
+        bool handleSearchKey(const KEY_EVENT_RECORD &key);
+
+        /**
+         * @brief Shows the match of the query at `rank` (0 = best).
+         *
+         * Keeps the last match and marks the search failing if nothing is found.
+         */
+        void search(size_t rank);
+
+        /**
+         * @brief Ends the history search.
+         *
+         * @param accept Take the match into the buffer; otherwise restore the line from before the search.
+         */
+        void endSearch(bool accept);
+
+        /**
+         * @brief Draws the search line: the query, then the match with the matched part highlighted.
+         */
+        void redrawSearch();
+
         /**
          * @brief Redraws the input line on the console.
          *
@@ -144,5 +179,23 @@ namespace Console
 
         /** Handle to the standard output stream. */
         HANDLE m_stdout = nullptr;
+
+        /** True while Ctrl+R search is active. */
+        bool m_searching = false;
+
+        /** Whether the last search step found nothing. */
+        bool m_searchFailed = false;
+
+        /** Text being searched for. */
+        std::wstring m_query;
+
+        /** Current match, if any. */
+        std::optional<History::Manager::SearchResult> m_match;
+
+        /** Rank of the current match among all matches of the query. */
+        size_t m_rank = 0;
+
+        /** Input line from before the search, restored on cancel. */
+        std::wstring m_beforeSearch;
     };
 }
@@ -0,0 +1,277 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\consoleOperations\Prompt.cpp
+// PURPOSE: Builds the interactive prompt from cached segments.
+
+// INCLUDE LIBRARIES
+
+#include <cwchar>
+
+#include "Prompt.hpp"
+#include "../headers/Console.hpp"
+#include "../headers/Unicode.hpp"
+#include "../env/EnvironmentCommands.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Reads the first bytes of a small file such as '.git/HEAD'.
+static bool readSmallFile(const std::wstring &path, std::string &out)
+{
+    HANDLE h = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, // git rewrites HEAD while we read
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+
+    char buffer[512];
+    DWORD read = 0;
+    BOOL ok = ReadFile(h, buffer, sizeof(buffer), &read, nullptr);
+    CloseHandle(h);
+
+    if (!ok)
+        return false;
+
+    out.assign(buffer, read);
+    return true;
+}
+
+/// @brief Strips surrounding whitespace and line endings.
+static std::string trim(const std::string &text)
+{
+    const size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+        return {};
+
+    const size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+/// @brief Formats a duration as "850ms", "12.4s" or "3m05s".
+static std::wstring formatDuration(std::chrono::steady_clock::duration elapsed)
+{
+    using namespace std::chrono;
+
+    const auto ms = duration_cast<milliseconds>(elapsed).count();
+    wchar_t buffer[32];
+
+    if (ms < 1000)
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%lldms", static_cast<long long>(ms));
+    else if (ms < 60000)
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%.1fs", ms / 1000.0);
+    else
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%lldm%02llds",
+                 static_cast<long long>(ms / 60000), static_cast<long long>((ms / 1000) % 60));
+
+    return buffer;
+}
+
+// FUNCTIONS
+
+namespace Console
+{
+    /**
+     * @brief Computes the static segments and starts the git worker.
+     */
+    Prompt::Prompt()
+    {
+        m_user = Environment::EnvironmentCommands::executeWHOAMI().value;
+        m_host = Environment::EnvironmentCommands::executeHOSTNAME().value;
+        refreshCwd();
+
+        m_worker = std::thread(&Prompt::gitWorker, this);
+    }
+
+    /**
+     * @brief Stops the git worker.
+     */
+    Prompt::~Prompt()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_requestCv.notify_one();
+
+        if (m_worker.joinable())
+            m_worker.join();
+    }
+
+    void Prompt::invalidateCwd()
+    {
+        s_cwdGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Prompt::setLastCommand(DWORD exitCode, std::chrono::steady_clock::duration elapsed)
+    {
+        m_lastStatus = exitCode;
+        m_lastDuration = elapsed;
+    }
+
+    void Prompt::refreshCwd()
+    {
+        m_cwdGeneration = s_cwdGeneration.load(std::memory_order_relaxed);
+        m_cwd = Environment::EnvironmentCommands::executePWD().value;
+    }
+
+    /**
+     * @brief Writes the prompt at the current cursor position.
+     *
+     * Never blocks on the git segment; see the class comment.
+     */
+    void Prompt::render()
+    {
+        if (m_cwdGeneration != s_cwdGeneration.load(std::memory_order_relaxed))
+            refreshCwd();
+
+        // HEAD can change without a 'cd' (e.g. 'git checkout'), so ask again every time
+        std::wstring branch;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_gitBranchDir == m_cwd) // the newest answer for this directory, however old
+                branch = m_gitBranch;
+
+            ++m_gitRequestId;
+            m_gitRequestDir = m_cwd;
+        }
+        m_requestCv.notify_one();
+
+        console::setColor(ConsoleColor::Blue);
+        console::write(m_user + L"@" + m_host + L" ");
+        console::reset();
+
+        console::setColor(ConsoleColor::Cyan);
+        console::write(m_cwd);
+        console::reset();
+
+        if (!branch.empty())
+        {
+            console::setColor(ConsoleColor::Purple);
+            console::write(L" (" + branch + L")");
+            console::reset();
+        }
+
+        if (m_lastStatus != 0)
+        {
+            console::setColor(ConsoleColor::Red);
+            console::write(L" [" + std::to_wstring(m_lastStatus) + L"]");
+            console::reset();
+        }
+
+        if (m_lastDuration >= DURATION_THRESHOLD)
+        {
+            console::setColor(ConsoleColor::Yellow);
+            console::write(L" " + formatDuration(m_lastDuration));
+            console::reset();
+        }
+
+        console::write(L" $ "); // user@HOSTNAME current\working\directory (branch) [status] duration $
+    }
+
+    /**
+     * @brief Serves git segment requests until the prompt is destroyed.
+     *
+     * Only the newest request is answered; requests that arrive while a
+     * lookup is running are coalesced into the next one.
+     */
+    void Prompt::gitWorker()
+    {
+        uint64_t handled = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_requestCv.wait(lock, [&]
+                             { return m_stop || m_gitRequestId != handled; });
+
+            if (m_stop)
+                return;
+
+            const uint64_t id = m_gitRequestId;
+            const std::wstring dir = m_gitRequestDir;
+
+            lock.unlock();
+            std::wstring branch = readGitBranch(dir);
+            lock.lock();
+
+            m_gitBranch = std::move(branch);
+            m_gitBranchDir = dir;
+            handled = id;
+        }
+    }
+
+    std::wstring Prompt::readGitBranch(const std::wstring &start)
+    {
+        std::wstring dir = start;
+
+        while (!dir.empty())
+        {
+            std::wstring dotGit = dir;
+            if (dotGit.back() != L'\\')
+                dotGit += L'\\';
+            dotGit += L".git";
+
+            DWORD attrs = GetFileAttributesW(dotGit.c_str());
+
+            if (attrs != INVALID_FILE_ATTRIBUTES)
+            {
+                std::wstring gitDir = dotGit;
+
+                if (!(attrs & FILE_ATTRIBUTE_DIRECTORY)) // worktree or submodule: ".git" is a "gitdir: <path>" file
+                {
+                    std::string content;
+                    if (!readSmallFile(dotGit, content) || content.compare(0, 7, "gitdir:") != 0)
+                        return L"";
+
+                    gitDir = unicode::utf8_to_utf16(trim(content.substr(7)));
+
+                    const bool absolute = gitDir.size() > 1 &&
+                                          (gitDir[1] == L':' || gitDir[0] == L'\\' || gitDir[0] == L'/');
+                    if (!absolute)
+                        gitDir = dir + L"\\" + gitDir;
+                }
+
+                std::string head;
+                if (!readSmallFile(gitDir + L"\\HEAD", head))
+                    return L"";
+
+                head = trim(head);
+
+                if (head.compare(0, 16, "ref: refs/heads/") == 0)
+                    return unicode::utf8_to_utf16(head.substr(16));
+
+                if (head.compare(0, 5, "ref: ") == 0)
+                    return unicode::utf8_to_utf16(head.substr(5));
+
+                return unicode::utf8_to_utf16(head.substr(0, 7)); // detached HEAD: short hash
+            }
+
+            const size_t slash = dir.find_last_of(L"\\/");
+            if (slash == std::wstring::npos || slash < 2 || slash + 1 == dir.size())
+                break; // reached a drive or share root
+
+            dir.erase(dir[1] == L':' && slash == 2 ? slash + 1 : slash); // keep "C:\" rather than "C:"
+        }
+
+        return L"";
+    }
+}
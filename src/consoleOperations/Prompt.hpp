@@ -0,0 +1,117 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\consoleOperations\Prompt.hpp
+// PURPOSE: Header file for 'src\consoleOperations\Prompt.cpp'. Builds the interactive prompt from cached segments.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <windows.h>
+
+namespace Console
+{
+    /**
+     * @brief Renders the prompt: user@host cwd (branch) [status] duration $
+     *
+     * Segments are refreshed by how often they can change:
+     *  - user and host are read once at construction,
+     *  - cwd is re-read only after invalidateCwd() (called by 'cd'),
+     *  - status and duration are handed over by the caller after each command,
+     *  - the git branch is read from '.git/HEAD' on a worker thread. render()
+     *    never waits for it: it shows the last value computed for the same
+     *    directory and asks for a fresh one, so a new directory or branch
+     *    shows up from the next prompt on. The only wait is for the worker's mutex, which is
+     *    never held while reading the file system.
+     */
+    class Prompt
+    {
+    public:
+        /** Commands faster than this do not show a duration segment. */
+        static constexpr std::chrono::milliseconds DURATION_THRESHOLD{500};
+
+        Prompt();
+        ~Prompt();
+
+        Prompt(const Prompt &) = delete;
+        Prompt &operator=(const Prompt &) = delete;
+
+        /**
+         * @brief Writes the prompt at the current cursor position.
+         */
+        void render();
+
+        /**
+         * @brief Records the result of the command that just finished.
+         *
+         * @param exitCode Exit status of the command.
+         * @param elapsed  Wall time the command took.
+         */
+        void setLastCommand(DWORD exitCode, std::chrono::steady_clock::duration elapsed);
+
+        /**
+         * @brief Marks the cached working directory as stale.
+         *
+         * Called whenever the shell changes its working directory.
+         */
+        static void invalidateCwd();
+
+    private:
+        /**
+         * @brief Finds the repository containing a directory and returns its branch.
+         *
+         * Walks up from dir looking for '.git' (a directory, or a file with a
+         * 'gitdir:' line for worktrees/submodules) and parses its HEAD.
+         *
+         * @param dir Absolute directory path.
+         * @return Branch name, short commit hash when detached, or empty outside a repository.
+         */
+        static std::wstring readGitBranch(const std::wstring &dir);
+
+        void refreshCwd();
+        void gitWorker();
+
+        std::wstring m_user; ///< Static segment
+        std::wstring m_host; ///< Static segment
+        std::wstring m_cwd;  ///< Cached until invalidated
+
+        uint64_t m_cwdGeneration = 0;                            ///< Generation m_cwd was read at
+        inline static std::atomic<uint64_t> s_cwdGeneration{1}; ///< Bumped by invalidateCwd()
+
+        DWORD m_lastStatus = 0;
+        std::chrono::steady_clock::duration m_lastDuration{};
+
+        // Git segment, shared with the worker thread
+        std::mutex m_mutex;
+        std::condition_variable m_requestCv;
+        std::wstring m_gitRequestDir;
+        uint64_t m_gitRequestId = 0;
+        std::wstring m_gitBranch;
+        std::wstring m_gitBranchDir; ///< Directory m_gitBranch was computed for
+        bool m_stop = false;
+
+        std::thread m_worker;
+    };
+}
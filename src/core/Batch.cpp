@@ -0,0 +1,234 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\core\Batch.cpp
+// PURPOSE: Streams commands from '-c', a script file or stdin into 'Shell.cpp'.
+
+// INCLUDE LIBRARIES
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <io.h>
+#include <fcntl.h>
+#include <windows.h>
+
+#include "../headers/Batch.hpp"
+#include "../headers/Shell.hpp"
+#include "../headers/Console.hpp"
+#include "../headers/Error.hpp"
+#include "../execution/Execution.hpp"
+
+// HELPER FUNCTIONS
+
+static constexpr DWORD READ_CHUNK_SIZE = 64 * 1024;
+
+/// @brief Prints a red error line on stderr.
+static void printError(const std::wstring &message)
+{
+    console::setColor(ConsoleColor::Red);
+    std::wcerr << message << std::endl;
+    console::reset();
+}
+
+/// @brief Runs one line unless it is blank or a comment.
+/// @return Exit status of the line, or -1 if nothing ran.
+static int runLine(std::wstring &line)
+{
+    if (!line.empty() && line.back() == L'\r')
+        line.pop_back();
+
+    const size_t first = line.find_first_not_of(L" \t");
+    if (first == std::wstring::npos || line[first] == L'#')
+        return -1;
+
+    Execution::Executor::Context ctx;
+    Shell::handleRawInput(line, ctx);
+    return static_cast<int>(ctx.exitCode);
+}
+
+/**
+ * @brief Splits UTF-8 input into lines as it arrives.
+ *
+ * Complete lines are converted and executed right away, so a producer
+ * writing into esh's stdin sees commands run before it closes the pipe.
+ */
+class LineFeeder
+{
+public:
+    void feed(const char *data, size_t size)
+    {
+        m_pending.append(data, size);
+
+        size_t start = 0;
+        size_t newline;
+
+        while ((newline = m_pending.find('\n', start)) != std::string::npos)
+        {
+            runUtf8(std::string_view(m_pending).substr(start, newline - start));
+            start = newline + 1;
+        }
+
+        m_pending.erase(0, start);
+    }
+
+    int status() const { return m_status; }
+
+    void finish()
+    {
+        if (!m_pending.empty())
+            runUtf8(m_pending);
+
+        m_pending.clear();
+    }
+
+private:
+    void runUtf8(std::string_view bytes)
+    {
+        if (m_firstLine)
+        {
+            m_firstLine = false;
+
+            if (bytes.substr(0, 3) == "\xEF\xBB\xBF") // UTF-8 BOM
+                bytes.remove_prefix(3);
+        }
+
+        // Reuse one buffer for every line instead of allocating per line
+        const int length = MultiByteToWideChar(CP_UTF8, 0, bytes.data(), static_cast<int>(bytes.size()), nullptr, 0);
+
+        m_line.resize(static_cast<size_t>(length));
+
+        if (length > 0)
+            MultiByteToWideChar(CP_UTF8, 0, bytes.data(), static_cast<int>(bytes.size()), m_line.data(), length);
+
+        const int status = runLine(m_line);
+        if (status >= 0)
+            m_status = status;
+    }
+
+    std::string m_pending;
+    std::wstring m_line;
+    bool m_firstLine = true;
+    int m_status = EXIT_SUCCESS; ///< Status of the last line that ran
+};
+
+/// @brief Reads a handle to the end and runs every line in it.
+static int runHandle(HANDLE handle)
+{
+    LineFeeder feeder;
+    std::string chunk(READ_CHUNK_SIZE, '\0');
+
+    DWORD read = 0;
+    while (ReadFile(handle, chunk.data(), READ_CHUNK_SIZE, &read, nullptr) && read > 0)
+    {
+        feeder.feed(chunk.data(), read);
+    }
+
+    feeder.finish();
+    return feeder.status();
+}
+
+/// @brief Runs each line of a '-c' argument.
+static int runCommand(const std::wstring &command)
+{
+    int status = EXIT_SUCCESS;
+    size_t start = 0;
+
+    while (start <= command.size())
+    {
+        size_t newline = command.find(L'\n', start);
+        if (newline == std::wstring::npos)
+            newline = command.size();
+
+        std::wstring line = command.substr(start, newline - start);
+
+        const int lineStatus = runLine(line);
+        if (lineStatus >= 0)
+            status = lineStatus;
+
+        start = newline + 1;
+    }
+
+    return status;
+}
+
+/// @brief Runs every line of a script file.
+static int runFile(const std::wstring &path)
+{
+    HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        Error err = makeLastError(L"esh: " + path);
+        console::setColor(ConsoleColor::Red);
+        std::wcerr << err.message;
+        console::reset();
+        return EXIT_FAILURE;
+    }
+
+    int status = runHandle(file);
+    CloseHandle(file);
+    return status;
+}
+
+// FUNCTIONS
+
+namespace Batch
+{
+    bool isInteractive(int argc)
+    {
+        return argc <= 1 && GetFileType(GetStdHandle(STD_INPUT_HANDLE)) == FILE_TYPE_CHAR;
+    }
+
+    int run(int argc, wchar_t *argv[])
+    {
+        // Output captured by another program is written as UTF-8 rather than UTF-16
+        if (GetFileType(GetStdHandle(STD_OUTPUT_HANDLE)) != FILE_TYPE_CHAR)
+            _setmode(_fileno(stdout), _O_U8TEXT);
+
+        if (GetFileType(GetStdHandle(STD_ERROR_HANDLE)) != FILE_TYPE_CHAR)
+            _setmode(_fileno(stderr), _O_U8TEXT);
+
+        if (argc <= 1)
+            return runHandle(GetStdHandle(STD_INPUT_HANDLE));
+
+        const std::wstring first = argv[1];
+
+        if (first == L"-c")
+        {
+            if (argc < 3)
+            {
+                printError(L"esh: -c: option requires an argument");
+                return EXIT_FAILURE;
+            }
+
+            return runCommand(argv[2]);
+        }
+
+        if (first == L"-")
+            return runHandle(GetStdHandle(STD_INPUT_HANDLE));
+
+        return runFile(first);
+    }
+}
@@ -0,0 +1,298 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\core\ByteScan.cpp
+// PURPOSE: Vectorized byte searches over raw buffers, with the instruction set picked at run time.
+
+// INCLUDE LIBRARIES
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#include "../headers/ByteScan.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief True if the CPU and the OS both support AVX2 (the OS must save the YMM registers).
+static bool hasAvx2()
+{
+    static const bool supported = []
+    {
+        int info[4];
+
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+
+    return supported;
+}
+
+/// @brief Byte-at-a-time tail of the vector loops.
+static const char *findLastScalar(const char *data, size_t size, char byte)
+{
+    while (size > 0)
+    {
+        --size;
+        if (data[size] == byte)
+            return data + size;
+    }
+
+    return nullptr;
+}
+
+/// @brief findLast, 16 bytes per step (SSE2 is always there on x64).
+static const char *findLastSse2(const char *data, size_t size, char byte)
+{
+    const __m128i needle = _mm_set1_epi8(byte);
+
+    while (size >= 16)
+    {
+        size -= 16;
+
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + size));
+        unsigned long mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+        unsigned long bit;
+        if (_BitScanReverse(&bit, mask))
+            return data + size + bit;
+    }
+
+    return findLastScalar(data, size, byte);
+}
+
+/// @brief findLast, 64 bytes per step.
+__attribute__((target("avx2"))) static const char *findLastAvx2(const char *data, size_t size, char byte)
+{
+    const __m256i needle = _mm256_set1_epi8(byte);
+
+    while (size >= 64)
+    {
+        size -= 64;
+
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + size));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + size + 32));
+
+        unsigned long highMask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)));
+        unsigned long lowMask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle)));
+
+        unsigned long bit;
+        if (_BitScanReverse(&bit, highMask))
+            return data + size + 32 + bit;
+        if (_BitScanReverse(&bit, lowMask))
+            return data + size + bit;
+    }
+
+    return findLastSse2(data, size, byte);
+}
+
+/// @brief Byte-at-a-time tail of the findNth vector loops.
+static const char *findNthScalar(const char *data, size_t size, char byte, size_t &n)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (data[i] == byte && --n == 0)
+            return data + i;
+    }
+
+    return nullptr;
+}
+
+/// @brief findNth, 16 bytes per step; walks the matches of each block bit by bit.
+static const char *findNthSse2(const char *data, size_t size, char byte, size_t &n)
+{
+    const __m128i needle = _mm_set1_epi8(byte);
+
+    while (size >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        unsigned long mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+        unsigned long bit;
+        while (_BitScanForward(&bit, mask))
+        {
+            if (--n == 0)
+                return data + bit;
+            mask &= mask - 1;
+        }
+
+        data += 16;
+        size -= 16;
+    }
+
+    return findNthScalar(data, size, byte, n);
+}
+
+/// @brief findNth, 64 bytes per step; blocks short of the n-th match only cost a popcount.
+__attribute__((target("avx2,popcnt"))) static const char *findNthAvx2(const char *data, size_t size, char byte, size_t &n)
+{
+    const __m256i needle = _mm256_set1_epi8(byte);
+
+    while (size >= 64)
+    {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 32));
+
+        unsigned long long mask =
+            static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle))) |
+            (static_cast<unsigned long long>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)))) << 32);
+
+        const size_t matches = static_cast<size_t>(_mm_popcnt_u64(mask));
+        if (matches >= n)
+        {
+            for (; n > 1; --n)
+                mask &= mask - 1; // drop the matches before the one we want
+            n = 0;
+
+            unsigned long bit;
+            _BitScanForward64(&bit, mask);
+            return data + bit;
+        }
+
+        n -= matches;
+        data += 64;
+        size -= 64;
+    }
+
+    return findNthSse2(data, size, byte, n);
+}
+
+/// @brief Bits set in a 32-bit mask, without needing the POPCNT instruction.
+static unsigned popcount32(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+/// @brief Byte-at-a-time tail of the countText vector loops.
+static void countTextScalar(const char *data, size_t size, bytescan::TextCounts &counts, bool &inWord)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        const bool space = bytescan::isSpace(data[i]);
+
+        counts.lines += data[i] == '\n';
+        counts.words += !space && !inWord;
+        inWord = !space;
+    }
+}
+
+/// @brief countText, 16 bytes per step.
+///
+/// A word starts at every non-space byte whose predecessor is a space; the
+/// predecessor of the first byte in a block is carried over in `inWord`.
+static void countTextSse2(const char *data, size_t size, bytescan::TextCounts &counts, bool &inWord)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i blank = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controlSpan = _mm_set1_epi8('\r' - '\t');
+
+    while (size >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+
+        __m128i offset = _mm_sub_epi8(block, tab); // \t..\r become 0..4, everything else more (unsigned)
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(offset, controlSpan), offset);
+        __m128i space = _mm_or_si128(control, _mm_cmpeq_epi8(block, blank));
+
+        const uint32_t spaceMask = static_cast<uint32_t>(_mm_movemask_epi8(space));
+        const uint32_t lineMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+        const uint32_t starts = ~spaceMask & ((spaceMask << 1) | (inWord ? 0u : 1u)) & 0xFFFF;
+
+        counts.lines += popcount32(lineMask);
+        counts.words += popcount32(starts);
+        inWord = (spaceMask & 0x8000) == 0;
+
+        data += 16;
+        size -= 16;
+    }
+
+    countTextScalar(data, size, counts, inWord);
+}
+
+/// @brief Whitespace and line break masks of 32 bytes.
+__attribute__((target("avx2"))) static inline void textMasksAvx2(const char *at, uint32_t &spaceMask, uint32_t &lineMask)
+{
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+
+    const __m256i offset = _mm256_sub_epi8(block, _mm256_set1_epi8('\t')); // \t..\r become 0..4
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+    const __m256i space = _mm256_or_si256(control, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')));
+
+    spaceMask = static_cast<uint32_t>(_mm256_movemask_epi8(space));
+    lineMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'))));
+}
+
+/// @brief countText, 64 bytes per step.
+__attribute__((target("avx2,popcnt"))) static void countTextAvx2(const char *data, size_t size, bytescan::TextCounts &counts, bool &inWord)
+{
+    while (size >= 64)
+    {
+        uint32_t spaceLow, lineLow, spaceHigh, lineHigh;
+        textMasksAvx2(data, spaceLow, lineLow);
+        textMasksAvx2(data + 32, spaceHigh, lineHigh);
+
+        const uint64_t spaceMask = spaceLow | (static_cast<uint64_t>(spaceHigh) << 32);
+        const uint64_t lineMask = lineLow | (static_cast<uint64_t>(lineHigh) << 32);
+        const uint64_t starts = ~spaceMask & ((spaceMask << 1) | (inWord ? 0u : 1u));
+
+        counts.lines += _mm_popcnt_u64(lineMask);
+        counts.words += _mm_popcnt_u64(starts);
+        inWord = (spaceMask >> 63) == 0;
+
+        data += 64;
+        size -= 64;
+    }
+
+    countTextSse2(data, size, counts, inWord);
+}
+
+// FUNCTIONS
+
+namespace bytescan
+{
+    const char *findLast(const char *data, size_t size, char byte)
+    {
+        return hasAvx2() ? findLastAvx2(data, size, byte) : findLastSse2(data, size, byte);
+    }
+
+    const char *findNth(const char *data, size_t size, char byte, size_t &n)
+    {
+        if (n == 0)
+            return nullptr;
+
+        return hasAvx2() ? findNthAvx2(data, size, byte, n) : findNthSse2(data, size, byte, n);
+    }
+
+    void countText(const char *data, size_t size, TextCounts &counts, bool &inWord)
+    {
+        if (hasAvx2())
+            countTextAvx2(data, size, counts, inWord);
+        else
+            countTextSse2(data, size, counts, inWord);
+    }
+}
@@ -19,75 +19,22 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
-#include <unordered_set>
-#include <mutex>
-#include <iostream>
+#include <string_view>
 
 #include "../headers/Commands.hpp"
-#include "../headers/Shell.hpp"
-#include "../external/json.hpp"
-
-using json = nlohmann::json;
-
-namespace
-{
-    std::unordered_set<std::wstring> builtinCommands;
-    std::once_flag initFlag;
-
-    /**
-     * @brief Loads built-in shell commands from the embedded JSON resource.
-     *
-     * Parses the JSON resource embedded in the executable and extracts
-     * the list of built-in commands defined under `commands.builtin`.
-     * Each command name is converted to `std::wstring` and stored in an
-     * `std::unordered_set` for fast lookup.
-     *
-     * This function is intended to be called exactly once and is protected
-     * by `std::call_once` to guarantee thread-safe, one-time initialization.
-     *
-     * On failure, an error message is written to standard error.
-     */
-    void loadBuiltins()
-    {
-        try
-        {
-            std::string json_text = Shell::load_resource_json(101);
-            json j = json::parse(json_text);
-
-            const auto &builtins = j.at("commands").at("builtin");
-
-            for (auto it = builtins.begin(); it != builtins.end(); ++it)
-            {
-                const std::string &cmd = it.key();
-                builtinCommands.insert(std::wstring(cmd.begin(), cmd.end()));
-            }
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "[esh] Failed to load built-in commands: "
-                      << e.what() << std::endl;
-        }
-    }
-}
 
 /**
  * @brief Checks whether a command is a built-in shell command.
  *
- * Ensures that the built-in command list is initialized, then performs
- * a constant-time lookup to determine whether the given command exists
- * in the built-in command set.
+ * Looks the name up in the compile-time perfect hash table generated
+ * from `ESH_COMMANDS`. The lookup is a single hash and comparison, never
+ * allocates, and needs no initialization at startup.
  *
  * @param command The command name to check.
  * @return true if the command is a built-in command, false otherwise.
  * 
  */
-bool Commands::isBuiltInCommand(const std::wstring &command)
+bool Commands::isBuiltInCommand(std::wstring_view command)
 {
-    std::call_once(initFlag, loadBuiltins);
-
-    if (builtinCommands.empty())
-        return false;
-
-    return builtinCommands.find(command) != builtinCommands.end();
+    return commandTable.contains(command);
 }
-
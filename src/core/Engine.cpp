@@ -67,7 +67,7 @@ void Engine::execute(CommandType command, uint16_t flags, const std::vector<std:
         break;
 
     case CommandGroup::PROCESS:
-        Process::ProcessCommands::execute(command, flags, args);
+        Process::ProcessCommands::execute(command, flags, args, ctx);
         break;
 
     case CommandGroup::ENVIRONMENT:
@@ -75,7 +75,7 @@ void Engine::execute(CommandType command, uint16_t flags, const std::vector<std:
         break;
 
     case CommandGroup::SHELL:
-        ShellCmds::ShellCommands::execute(command, flags, args);
+        ShellCmds::ShellCommands::execute(command, flags, args, ctx);
         break;
 
     case CommandGroup::SYSTEM:
@@ -86,6 +86,7 @@ void Engine::execute(CommandType command, uint16_t flags, const std::vector<std:
         console::setColor(ConsoleColor::Red);
         std::wcerr << L"Unknown or unsupported command" << std::endl;
         console::reset();
+        ctx.exitCode = 1;
         break;
     }
 }
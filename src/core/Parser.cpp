@@ -23,40 +23,191 @@ limitations under the License.
 #include <string>
 
 #include "../headers/Parser.hpp"
-#include "../execution/Execution.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Maps a redirection token to its AST form. Returns false for other tokens.
+static bool toRedirection(Lexer::TokenType type, Ast::Redirection &out)
+{
+    switch (type)
+    {
+    case Lexer::TOKEN_INPUT_REDIRECTION:
+        out = {Ast::RedirectType::STDIN, false, {}};
+        return true;
+    case Lexer::TOKEN_OUTPUT_REDIRECTION_ONE:
+        out = {Ast::RedirectType::STDOUT, false, {}};
+        return true;
+    case Lexer::TOKEN_OUTPUT_REDIRECTION_TWO:
+        out = {Ast::RedirectType::STDOUT, true, {}};
+        return true;
+    case Lexer::TOKEN_ERROR_REDIRECTION_ONE:
+        out = {Ast::RedirectType::STDERR, false, {}};
+        return true;
+    case Lexer::TOKEN_ERROR_REDIRECTION_TWO:
+        out = {Ast::RedirectType::STDERR, true, {}};
+        return true;
+    case Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_ONE:
+        out = {Ast::RedirectType::STDOUT_STDERR, false, {}};
+        return true;
+    case Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO:
+        out = {Ast::RedirectType::STDOUT_STDERR, true, {}};
+        return true;
+    case Lexer::TOKEN_ERROR_TO_OUTPUT_REDIRECTION:
+        out = {Ast::RedirectType::STDERR_TO_STDOUT, false, {}};
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// @brief Builds a parse error result.
+static Result<std::shared_ptr<const Ast::Sequence>> syntaxError(const std::wstring &message)
+{
+    Result<std::shared_ptr<const Ast::Sequence>> result;
+    result.error.message = L"esh: syntax error: " + message;
+    return result;
+}
 
 /**
- * @brief Parses a sequence of lexer tokens and dispatches execution.
+ * @brief Builds a syntax tree from a sequence of lexer tokens.
+ *
+ * The grammar is flat:
+ *
+ *   sequence := pipeline ((';' | '&') pipeline)* [';' | '&']
+ *   pipeline := command ('|' command)*
+ *   command  := (word | redirection)+
  *
- * Acts as the bridge between parsing and execution layers. This function
- * forwards the fully tokenized input to the executor, which is responsible
- * for handling pipelines, redirections, and command execution.
+ * The first word of a command decides whether it is a built-in. For
+ * built-ins, flag tokens are folded into a bitmask; for external programs
+ * every word is kept as an argv entry. Lexemes are copied out of the
+ * token views, so the returned plan does not depend on the input buffer
+ * and can be cached and re-run.
  *
- * @param tokens The list of tokens produced by the lexer.
- * @param ctx Execution context carrying runtime state and I/O handles.
+ * @param tokens The list of tokens produced by the lexer (EOF-terminated).
+ * @return The validated plan, or a syntax error. An empty line yields an empty sequence.
  */
-void Parser::parseTokens(const std::vector<Lexer::Token>& tokens, Execution::Executor::Context& ctx)
+Result<std::shared_ptr<const Ast::Sequence>> Parser::parseTokens(const std::vector<Lexer::Token> &tokens)
 {
-    Execution::Executor::run(tokens, ctx);
+    auto plan = std::make_shared<Ast::Sequence>();
+
+    Ast::Pipeline pipeline;
+    Ast::Command command;
+    bool hasWord = false;
+
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        const auto &t = tokens[i];
+
+        Ast::Redirection redirection;
+        if (toRedirection(t.type, redirection))
+        {
+            if (redirection.type != Ast::RedirectType::STDERR_TO_STDOUT)
+            {
+                const auto &next = tokens[i + 1 < tokens.size() ? i + 1 : i];
+                Ast::Redirection ignored;
+
+                if (i + 1 >= tokens.size() ||
+                    next.type == Lexer::TOKEN_EOF ||
+                    next.type == Lexer::TOKEN_PIPELINE ||
+                    next.type == Lexer::TOKEN_SEMICOLON ||
+                    next.type == Lexer::TOKEN_AMPERSAND ||
+                    toRedirection(next.type, ignored))
+                {
+                    return syntaxError(L"missing file name after '" + std::wstring(t.lexeme) + L"'");
+                }
+
+                redirection.target.assign(next.lexeme);
+                ++i;
+            }
+
+            command.redirections.push_back(std::move(redirection));
+            continue;
+        }
+
+        switch (t.type)
+        {
+        case Lexer::TOKEN_PIPELINE:
+        case Lexer::TOKEN_SEMICOLON:
+        case Lexer::TOKEN_AMPERSAND:
+        case Lexer::TOKEN_EOF:
+        {
+            const bool emptyCommand = !hasWord;
+
+            if (emptyCommand && !command.redirections.empty())
+                return syntaxError(L"redirection without a command");
+
+            if (emptyCommand && (t.type == Lexer::TOKEN_PIPELINE || !pipeline.commands.empty()))
+                return syntaxError(L"missing command around '|'");
+
+            if (emptyCommand && t.type == Lexer::TOKEN_AMPERSAND)
+                return syntaxError(L"missing command before '&'");
+
+            if (!emptyCommand)
+            {
+                pipeline.commands.push_back(std::move(command));
+                command = Ast::Command();
+                hasWord = false;
+            }
+
+            if (t.type != Lexer::TOKEN_PIPELINE && !pipeline.commands.empty())
+            {
+                pipeline.background = t.type == Lexer::TOKEN_AMPERSAND;
+                plan->pipelines.push_back(std::move(pipeline));
+                pipeline = Ast::Pipeline();
+            }
+            break;
+        }
+
+        default:
+            if (!hasWord)
+            {
+                hasWord = true;
+                command.builtin = t.type == Lexer::TOKEN_COMMAND
+                                      ? parseCommand(t.lexeme)
+                                      : CommandType::RESERVED;
+
+                if (command.isBuiltin())
+                    break;
+            }
+
+            if (command.isBuiltin() && t.type == Lexer::TOKEN_FLAG)
+                command.flags |= parseFlag(t.lexeme);
+            else
+                command.args.emplace_back(t.lexeme);
+            break;
+        }
+    }
+
+    Result<std::shared_ptr<const Ast::Sequence>> result;
+    result.value = std::move(plan);
+    return result;
 }
 
 /**
  * @brief Resolves a command token to its corresponding command type.
  *
- * Looks up the given command string in the internal command map and returns
- * the associated CommandType enum value.
+ * Looks up the given command string in the compile-time command table and
+ * returns the associated CommandType enum value.
  *
  * If the command is not found, a reserved command value is returned.
  *
- * @param token The command token as a wide string.
+ * @param token The command token.
  * @return The resolved CommandType, or a reserved value if not found.
  */
-CommandType Parser::parseCommand(const std::wstring &token)
+CommandType Parser::parseCommand(std::wstring_view token)
 {
-    auto it = commandMap.find(token);
-    if (it != commandMap.end())
-        return it->second;
-    return static_cast<CommandType>(0x00); // RESERVED
+    return commandTable.lookup(token, CommandType::RESERVED);
+}
+
+/**
+ * @brief Resolves a single flag token to its bit.
+ *
+ * @param token The flag token (e.g. "-r").
+ * @return The flag's bit, or 0 for unknown flags.
+ */
+uint16_t Parser::parseFlag(std::wstring_view token)
+{
+    return static_cast<uint16_t>(flagTable.lookup(token, static_cast<Flag>(0)));
 }
 
 /**
@@ -75,11 +226,7 @@ uint16_t Parser::parseFlags(const std::vector<std::wstring> &tokens)
     uint16_t result = 0;
     for (const auto &t : tokens)
     {
-        auto it = flagMap.find(t);
-        if (it != flagMap.end())
-        {
-            result |= static_cast<uint16_t>(it->second);
-        }
+        result |= parseFlag(t);
     }
     return result;
 }
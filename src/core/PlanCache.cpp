@@ -0,0 +1,97 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\core\PlanCache.cpp
+// PURPOSE: Keeps recently parsed plans so repeated lines skip the lexer and parser.
+
+// INCLUDE LIBRARIES
+
+#include "../headers/PlanCache.hpp"
+
+/**
+ * @brief Returns the shell-wide plan cache.
+ */
+PlanCache &PlanCache::instance()
+{
+    static PlanCache cache(DEFAULT_CAPACITY);
+    return cache;
+}
+
+/**
+ * @brief Looks up a line and marks it most recently used.
+ *
+ * @param line Raw input line.
+ * @return The cached plan, or nullptr on a miss.
+ */
+PlanCache::Plan PlanCache::find(const std::wstring &line)
+{
+    auto it = m_index.find(line);
+    if (it == m_index.end())
+    {
+        ++m_misses;
+        return nullptr;
+    }
+
+    ++m_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second); // iterators stay valid
+    return it->second->second;
+}
+
+/**
+ * @brief Stores a plan, evicting the least recently used one when full.
+ *
+ * @param line Raw input line.
+ * @param plan Validated plan.
+ */
+void PlanCache::insert(const std::wstring &line, Plan plan)
+{
+    if (m_capacity == 0 || !plan)
+        return;
+
+    auto it = m_index.find(line);
+    if (it != m_index.end())
+    {
+        it->second->second = std::move(plan);
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+
+    m_entries.emplace_front(line, std::move(plan));
+    m_index.emplace(m_entries.front().first, m_entries.begin());
+}
+
+/**
+ * @brief Drops every cached plan. Hit/miss counters are kept.
+ */
+void PlanCache::clear()
+{
+    m_index.clear();
+    m_entries.clear();
+}
+
+/**
+ * @brief Returns the hit/miss counters and current occupancy.
+ */
+PlanCache::Stats PlanCache::stats() const
+{
+    return {m_hits, m_misses, m_entries.size(), m_capacity};
+}
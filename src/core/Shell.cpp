@@ -29,31 +29,54 @@ limitations under the License.
 #include "../headers/Lexer.hpp"
 #include "../headers/Token.hpp"
 #include "../headers/Parser.hpp"
+#include "../headers/PlanCache.hpp"
+#include "../headers/Console.hpp"
 #include "../execution/Execution.hpp"
 
 /**
  * @brief Processes raw shell input through the lexical and parsing stages.
  *
  * This function serves as the entry point between user-provided raw input
- * and the execution pipeline. It performs no execution itself; instead,
- * it orchestrates the transformation of the input through:
+ * and the execution pipeline. It orchestrates:
  *
- *  - Tokenization (lexical analysis)
- *  - Parsing and semantic interpretation
+ *  - Plan cache lookup keyed by the raw line
+ *  - Tokenization (lexical analysis) and parsing into a plan, on a miss
+ *  - Handing the plan to the executor
  *
- * All resulting execution state is stored within the provided execution
- * context.
+ * Syntax errors are reported and nothing is executed.
  *
  * @param raw_input The raw command line input provided by the user.
  * @param ctx       Execution context that accumulates parsing and execution state.
  */
 void Shell::handleRawInput(std::wstring &raw_input, Execution::Executor::Context &ctx)
 {
-    // Perform lexical analysis on the raw input
-    auto tokens = Token::tokenizeInput(raw_input, ctx);
+    auto &cache = PlanCache::instance();
+    PlanCache::Plan plan = cache.find(raw_input);
 
-    // Parse tokens and populate execution context
-    Parser::parseTokens(tokens, ctx);
+    if (!plan)
+    {
+        // Perform lexical analysis on the raw input (tokens view into raw_input)
+        Lexer::TokenStream stream;
+        Token::tokenizeInput(raw_input, stream, ctx);
+
+        // Build the plan once; later runs of the same line come from the cache
+        auto parsed = Parser::parseTokens(stream.tokens);
+        if (!parsed.ok())
+        {
+            console::setColor(ConsoleColor::Red);
+            std::wcerr << parsed.error.message << std::endl;
+            console::reset();
+            ctx.exitCode = 2; // usage error, as in POSIX shells
+            return;
+        }
+
+        plan = std::move(parsed.value);
+
+        if (!plan->pipelines.empty())
+            cache.insert(raw_input, plan);
+    }
+
+    Execution::Executor::run(*plan, ctx);
 }
 
 /**
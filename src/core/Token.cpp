@@ -19,154 +19,350 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <string>
-#include <algorithm>
-#include <cctype>
-#include <iostream>
+#include <string_view>
 
 #include "../headers/Token.hpp"
 #include "../headers/Commands.hpp"
 
+namespace
+{
+    /**
+     * @brief Character classes driving the lexer's transition table.
+     */
+    enum CharClass : uint8_t
+    {
+        CC_WORD,     ///< Any ordinary character (including all non-ASCII)
+        CC_SPACE,    ///< ' ', '\t', '\r', '\n'
+        CC_DQUOTE,   ///< "
+        CC_SQUOTE,   ///< '
+        CC_ESCAPE,   ///< Backslash
+        CC_OPERATOR, ///< | < > & ;
+        CC_COUNT
+    };
+
+    /**
+     * @brief States of the word-scanning DFA.
+     */
+    enum LexState : uint8_t
+    {
+        ST_WORD,   ///< Outside quotes
+        ST_DQUOTE, ///< Inside "..."
+        ST_SQUOTE, ///< Inside '...'
+        ST_COUNT
+    };
+
+    /**
+     * @brief What the scanner does with the current character.
+     */
+    enum LexAction : uint8_t
+    {
+        ACT_APPEND, ///< Keep the character as part of the word
+        ACT_QUOTE,  ///< Drop the quote character and switch state
+        ACT_ESCAPE, ///< Backslash: take the next character literally if it is escapable here
+        ACT_END     ///< The word ends before this character
+    };
+
+    struct Transition
+    {
+        LexState next;
+        LexAction action;
+    };
+
+    constexpr std::array<uint8_t, 128> makeClassTable()
+    {
+        std::array<uint8_t, 128> table{};
+
+        table[L' '] = CC_SPACE;
+        table[L'\t'] = CC_SPACE;
+        table[L'\r'] = CC_SPACE;
+        table[L'\n'] = CC_SPACE;
+
+        table[L'"'] = CC_DQUOTE;
+        table[L'\''] = CC_SQUOTE;
+        table[L'\\'] = CC_ESCAPE;
+
+        table[L'|'] = CC_OPERATOR;
+        table[L'<'] = CC_OPERATOR;
+        table[L'>'] = CC_OPERATOR;
+        table[L'&'] = CC_OPERATOR;
+        table[L';'] = CC_OPERATOR;
+
+        return table;
+    }
+
+    constexpr std::array<uint8_t, 128> classTable = makeClassTable();
+
+    //                                       WORD                   SPACE                  DQUOTE                  SQUOTE                  ESCAPE                   OPERATOR
+    constexpr Transition transitions[ST_COUNT][CC_COUNT] = {
+        /* ST_WORD   */ {{ST_WORD, ACT_APPEND},   {ST_WORD, ACT_END},      {ST_DQUOTE, ACT_QUOTE}, {ST_SQUOTE, ACT_QUOTE}, {ST_WORD, ACT_ESCAPE},   {ST_WORD, ACT_END}},
+        /* ST_DQUOTE */ {{ST_DQUOTE, ACT_APPEND}, {ST_DQUOTE, ACT_APPEND}, {ST_WORD, ACT_QUOTE},   {ST_DQUOTE, ACT_APPEND}, {ST_DQUOTE, ACT_ESCAPE}, {ST_DQUOTE, ACT_APPEND}},
+        /* ST_SQUOTE */ {{ST_SQUOTE, ACT_APPEND}, {ST_SQUOTE, ACT_APPEND}, {ST_SQUOTE, ACT_APPEND}, {ST_WORD, ACT_QUOTE},  {ST_SQUOTE, ACT_APPEND}, {ST_SQUOTE, ACT_APPEND}},
+    };
+
+    inline CharClass classify(wchar_t ch)
+    {
+        return ch < 128 ? static_cast<CharClass>(classTable[ch]) : CC_WORD;
+    }
+
+    /**
+     * @brief Decides whether a backslash escapes the character after it.
+     *
+     * Backslash is the Windows path separator, so it only escapes characters
+     * that would otherwise end or split the word: whitespace, quotes and
+     * operators outside quotes, and the double quote inside "...".
+     * Everything else (e.g. `C:\Users`, `\n` for echo) stays literal.
+     */
+    inline bool isEscapable(LexState state, wchar_t next)
+    {
+        const CharClass cc = classify(next);
+
+        if (state == ST_DQUOTE)
+            return cc == CC_DQUOTE;
+
+        return cc == CC_SPACE || cc == CC_DQUOTE || cc == CC_SQUOTE || cc == CC_OPERATOR;
+    }
+
+    /**
+     * @brief Matches the longest operator starting at `pos`.
+     *
+     * @param in   Input line.
+     * @param pos  Position of the first operator character.
+     * @param type Receives the operator's token type.
+     * @return Length of the operator, or 0 if no operator starts here.
+     */
+    std::size_t matchOperator(std::wstring_view in, std::size_t pos, Lexer::TokenType &type)
+    {
+        auto at = [&](std::size_t i) -> wchar_t
+        {
+            return pos + i < in.size() ? in[pos + i] : L'\0';
+        };
+
+        switch (in[pos])
+        {
+        case L'|':
+            type = Lexer::TOKEN_PIPELINE;
+            return 1;
+
+        case L';':
+            type = Lexer::TOKEN_SEMICOLON;
+            return 1;
+
+        case L'<':
+            type = Lexer::TOKEN_INPUT_REDIRECTION;
+            return 1;
+
+        case L'>':
+            if (at(1) == L'>')
+            {
+                type = Lexer::TOKEN_OUTPUT_REDIRECTION_TWO;
+                return 2;
+            }
+            type = Lexer::TOKEN_OUTPUT_REDIRECTION_ONE;
+            return 1;
+
+        case L'&':
+            if (at(1) == L'>')
+            {
+                if (at(2) == L'>')
+                {
+                    type = Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO;
+                    return 3;
+                }
+                type = Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_ONE;
+                return 2;
+            }
+            type = Lexer::TOKEN_AMPERSAND;
+            return 1;
+
+        case L'2': // only called at a word boundary, so "file2>x" never gets here
+            if (at(1) != L'>')
+                return 0;
+            if (at(2) == L'>')
+            {
+                type = Lexer::TOKEN_ERROR_REDIRECTION_TWO;
+                return 3;
+            }
+            if (at(2) == L'&' && at(3) == L'1')
+            {
+                type = Lexer::TOKEN_ERROR_TO_OUTPUT_REDIRECTION;
+                return 4;
+            }
+            type = Lexer::TOKEN_ERROR_REDIRECTION_ONE;
+            return 2;
+
+        default:
+            return 0;
+        }
+    }
+}
+
 /**
  * @brief Splits raw input into a sequence of lexical tokens.
  *
- * This function performs a whitespace-based tokenization of the input
- * string and classifies each token according to shell syntax rules.
- * It does not perform quoting, escaping, or expansion.
+ * Single pass over the input driven by a character-class table and a
+ * small DFA (outside quotes, inside "...", inside '...'). Operators are
+ * recognized even when glued to words (`ls>out`, `a|b`, `2>&1`).
+ *
+ * Plain words are emitted as views into `input`. Words containing quotes
+ * or escapes are unescaped into `out.storage`, which is allocated once per
+ * line (at most the input length), so no token allocates on its own.
  *
  * An explicit EOF token is appended at the end of the token stream.
  *
  * @param input Raw input string provided by the user.
- * @param ctx   Execution context updated during token classification.
- * @return Vector of lexical tokens.
+ * @param out   Token stream receiving the tokens.
+ * @param ctx   Execution context updated when pipelines/redirections are seen.
  */
-std::vector<Lexer::Token> Token::tokenizeInput(const std::wstring &input, Execution::Executor::Context &ctx)
+void Token::tokenizeInput(std::wstring_view input, Lexer::TokenStream &out, Execution::Executor::Context &ctx)
 {
-    std::vector<Lexer::Token> tokens;
+    const std::size_t len = input.size();
+
+    out.tokens.clear();
+    out.tokens.reserve(len + 1); // every token consumes at least one character
+    out.storageUsed = 0;
 
     std::size_t pos = 0;
-    const std::size_t len = input.length();
+    bool commandPosition = true;
 
     while (pos < len)
     {
+        const CharClass cc = classify(input[pos]);
 
-        while (pos < len && input[pos] == ' ')
+        if (cc == CC_SPACE)
         {
             ++pos;
+            continue;
+        }
+
+        // ---- Operators ----
+        if (cc == CC_OPERATOR || input[pos] == L'2')
+        {
+            Lexer::TokenType type{};
+            const std::size_t opLen = matchOperator(input, pos, type);
+
+            if (opLen != 0)
+            {
+                out.tokens.push_back({type, input.substr(pos, opLen)});
+                pos += opLen;
+
+                if (type == Lexer::TOKEN_PIPELINE)
+                    ctx.pipelineEnabled = true;
+                else if (type != Lexer::TOKEN_SEMICOLON && type != Lexer::TOKEN_AMPERSAND)
+                    ctx.redirectionEnabled = true;
+
+                commandPosition = type == Lexer::TOKEN_PIPELINE ||
+                                  type == Lexer::TOKEN_SEMICOLON ||
+                                  type == Lexer::TOKEN_AMPERSAND;
+                continue;
+            }
         }
 
-        if (pos >= len)
-            break;
+        // ---- Words ----
+        const std::size_t start = pos;
+        LexState state = ST_WORD;
+        bool quoted = false;
+
+        wchar_t *cooked = nullptr; // set once the word differs from the raw input
+        std::size_t cookedLen = 0;
 
-        std::size_t start = pos;
-        while (pos < len && input[pos] != ' ')
+        auto beginCooking = [&]()
         {
+            if (cooked)
+                return;
+
+            if (!out.storage)
+                out.storage = std::make_unique<wchar_t[]>(len);
+
+            cooked = out.storage.get() + out.storageUsed;
+            cookedLen = pos - start;
+            std::memcpy(cooked, input.data() + start, cookedLen * sizeof(wchar_t));
+        };
+
+        while (pos < len)
+        {
+            const wchar_t ch = input[pos];
+            const Transition t = transitions[state][classify(ch)];
+
+            if (t.action == ACT_END)
+                break;
+
+            if (t.action == ACT_QUOTE)
+            {
+                beginCooking();
+                quoted = true;
+                state = t.next;
+                ++pos;
+                continue;
+            }
+
+            if (t.action == ACT_ESCAPE && pos + 1 < len && isEscapable(state, input[pos + 1]))
+            {
+                beginCooking();
+                cooked[cookedLen++] = input[pos + 1];
+                pos += 2;
+                continue;
+            }
+
+            if (cooked)
+                cooked[cookedLen++] = ch;
+            state = t.next;
             ++pos;
         }
 
-        std::wstring token = input.substr(start, pos - start); // Gets the token without blank char.
-        Lexer::TokenType type = Token::identifyTokenType(token, ctx);
+        std::wstring_view word = input.substr(start, pos - start);
+        if (cooked)
+        {
+            word = std::wstring_view(cooked, cookedLen);
+            out.storageUsed += cookedLen;
+        }
+
+        const Lexer::TokenType type = quoted
+                                          ? Lexer::TOKEN_STRING
+                                          : Token::identifyTokenType(word, commandPosition);
 
-        tokens.push_back({type, token});
+        out.tokens.push_back({type, word});
+        commandPosition = false;
     }
 
-    tokens.push_back({Lexer::TOKEN_EOF, L""}); // End of input
-
-    return tokens;
+    out.tokens.push_back({Lexer::TOKEN_EOF, std::wstring_view()}); // End of input
 }
 
 /**
- * @brief Determines the lexical type of a token.
+ * @brief Determines the lexical type of an unquoted word.
  *
- * This function classifies a token based on its textual form and may
- * update the execution context if the token represents a pipeline or
- * redirection operator.
+ * Numbers (optionally negative) and flags are recognized from the text.
+ * A word is only a command when it sits in command position, so
+ * `echo ls` passes `ls` through as an argument.
  *
- * @param token Token text.
- * @param ctx   Execution context modified for pipeline/redirection state.
+ * @param token           Word text.
+ * @param commandPosition True if the word starts a command.
  * @return Token type.
  */
-Lexer::TokenType Token::identifyTokenType(const std::wstring &token, Execution::Executor::Context &ctx)
+Lexer::TokenType Token::identifyTokenType(std::wstring_view token, bool commandPosition)
 {
+    if (token.empty())
+        return Lexer::TOKEN_EXECUTEE;
 
     // Numeric (supports negative integers)
-    if (token[0] == L'-' && token.size() > 1)
-    {
-        if (std::all_of(token.begin() + 1, token.end(),
-                        [](unsigned char c)
-                        { return std::isdigit(c); }))
-        {
-            return Lexer::TOKEN_NUMBER;
-        }
-        return Lexer::TOKEN_FLAG;
-    }
-
-    if (std::all_of(token.begin(), token.end(),
-                    [](unsigned char c)
-                    { return std::isdigit(c); }))
-    {
-        return Lexer::TOKEN_NUMBER;
-    }
+    const bool dashed = token[0] == L'-' && token.size() > 1;
+    const std::wstring_view digits = dashed ? token.substr(1) : token;
 
-    if (token.size() >= 2 &&
-        token.front() == L'"' &&
-        token.back() == L'"')
-    {
-        return Lexer::TOKEN_STRING;
-    }
+    bool allDigits = true;
+    for (wchar_t ch : digits)
+        allDigits &= (ch >= L'0' && ch <= L'9');
 
-    if (token == L"|")
-    {
-        ctx.pipelineEnabled = true;
-        return Lexer::TOKEN_PIPELINE;
-    }
-
-    if (token == L"<")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_INPUT_REDIRECTION;
-    }
-
-    if (token == L">>")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_OUTPUT_REDIRECTION_TWO;
-    }
-
-    if (token == L">")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_OUTPUT_REDIRECTION_ONE;
-    }
-
-    if (token == L"2>>")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_ERROR_REDIRECTION_TWO;
-    }
-
-    if (token == L"2>")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_ERROR_REDIRECTION_ONE;
-    }
-
-    if (token == L"&>>")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO;
-    }
+    if (allDigits)
+        return Lexer::TOKEN_NUMBER;
 
-    if (token == L"&>")
-    {
-        ctx.redirectionEnabled = true;
-        return Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_ONE;
-    }
+    if (dashed)
+        return Lexer::TOKEN_FLAG;
 
-    if (Commands::isBuiltInCommand(token))
-    {
+    if (commandPosition && Commands::isBuiltInCommand(token))
         return Lexer::TOKEN_COMMAND;
-    }
 
     return Lexer::TOKEN_EXECUTEE;
 }
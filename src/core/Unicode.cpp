@@ -113,4 +113,41 @@ namespace unicode
 
         return utf8;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Returns how many leading bytes of a UTF-8 buffer form whole characters.
+     *
+     * Used when UTF-8 arrives in fixed-size chunks: the bytes past the
+     * returned length start a character that continues in the next chunk.
+     *
+     * @param data UTF-8 bytes.
+     * @param size Number of bytes.
+     * @return Length of the prefix that does not end inside a multi-byte sequence.
+     */
+    size_t utf8_complete_length(const char *data, size_t size)
+    {
+        // Walk back over at most three continuation bytes to the lead byte
+        size_t i = size;
+        size_t back = 0;
+        while (i > 0 && back < 3 && (static_cast<unsigned char>(data[i - 1]) & 0xC0) == 0x80)
+        {
+            --i;
+            ++back;
+        }
+
+        if (i == 0)
+            return size; // only continuation bytes: not ours to fix
+
+        unsigned char lead = static_cast<unsigned char>(data[i - 1]);
+
+        size_t length = 1;
+        if ((lead & 0xE0) == 0xC0)
+            length = 2;
+        else if ((lead & 0xF0) == 0xE0)
+            length = 3;
+        else if ((lead & 0xF8) == 0xF0)
+            length = 4;
+
+        return (back + 1 < length) ? i - 1 : size;
+    }
+}
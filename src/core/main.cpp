@@ -20,6 +20,7 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <chrono>
 #include <iostream>
 #include <string>
 
@@ -27,6 +28,7 @@ limitations under the License.
 #include <fcntl.h>
 
 #include "../headers/Shell.hpp"
+#include "../headers/Batch.hpp"
 #include "../headers/Console.hpp"
 #include "../headers/Result.hpp"
 #include "../headers/Error.hpp"
@@ -35,9 +37,14 @@ limitations under the License.
 #include "../platform/AppDataPath.hpp"
 #include "../history/HistoryManager.hpp"
 #include "../consoleOperations/ConsoleInput.hpp"
+#include "../consoleOperations/Prompt.hpp"
 #include "../execution/Execution.hpp"
+#include "../process/Jobs.hpp"
+#include "../process/Interrupt.hpp"
+#include "../file/Purger.hpp"
+#include "../file/MoveEngine.hpp"
 
-int wmain()
+int wmain(int argc, wchar_t *argv[])
 {
     Platform::init(); // Initialize AppData for esh
 
@@ -57,41 +64,53 @@ int wmain()
         return EXIT_FAILURE;
     }
 
+    // esh -c "command", esh script.esh or piped stdin: no prompt, no line editor, no history
+    if (!Batch::isInteractive(argc))
+    {
+        int code = Batch::run(argc, argv);
+        FileIO::Purger::instance().drain(); // a script's 'rm -r' is finished before esh exits
+        return code;
+    }
+
     // initialize command history
     History::Manager history;
     history.initialize();
 
     Console::Input input(history);
+    Console::Prompt prompt; // user/host read once, cwd refreshed on 'cd', git branch in the background
+
+    Process::Interrupt::install(); // Ctrl+C stops the running built-in instead of esh
+
+    FileIO::Purger::instance().resume(); // trees 'rm -r' left behind when esh last exited
+
+    if (!FileIO::MoveEngine::pending().empty())
+        console::writeln(L"esh: an 'mv' between volumes was interrupted; 'mv --resume' finishes it, 'mv --rollback' undoes it");
 
     while (true)
     {
         Execution::Executor::Context ctx; // One ctx along the program. 
         ctx.pipelineEnabled = false; // we do not have any pipeline or redirection yet.
         ctx.redirectionEnabled = false;
-        
-        auto who = Environment::EnvironmentCommands::executeWHOAMI();
-        auto host = Environment::EnvironmentCommands::executeHOSTNAME();
-        auto pwd = Environment::EnvironmentCommands::executePWD();
-
-        console::setColor(ConsoleColor::Blue);
-        console::write(who.value);
-        console::write(L"@");
-        console::write(host.value);
-        console::write(L" ");
-        console::reset();
 
-        console::setColor(ConsoleColor::Cyan);
-        console::write(pwd.value);
-        console::reset();
+        Process::JobTable::instance().reportFinished(); // "[1]  Done  ..." for background jobs
 
-        console::write(L" $ "); // user@HOSTNAME current\working\directory $
+        prompt.render();
 
         input.setPromptStart(); // set where the history buffer must be written
 
         std::wstring raw_input = input.readLine(); // get the input
 
         history.add(raw_input);
-        Shell::handleRawInput(raw_input, ctx);
+
+        if (raw_input.find_first_not_of(L" \t") != std::wstring::npos) // blank lines keep the last status
+        {
+            Process::Interrupt::reset();
+            ctx.interrupt = Process::Interrupt::event();
+
+            const auto start = std::chrono::steady_clock::now();
+            Shell::handleRawInput(raw_input, ctx);
+            prompt.setLastCommand(ctx.exitCode, std::chrono::steady_clock::now() - start);
+        }
 
         console::writeln(L"");
     }
@@ -31,6 +31,7 @@ limitations under the License.
 #include "../headers/Unicode.hpp"
 #include "../headers/Helper.hpp"
 #include "EnvironmentCommands.hpp"
+#include "../consoleOperations/Prompt.hpp"
 
 namespace Environment
 {
@@ -71,7 +72,7 @@ namespace Environment
             break;
 
         case CommandType::CD:
-            executeCD(args[0]);
+            executeCD(args.empty() ? L"" : args[0]);
             break;
 
         default:
@@ -108,6 +109,8 @@ namespace Environment
         if (!SetCurrentDirectoryW(path.c_str()))
             return {false, makeLastError(L"cd")};
 
+        Console::Prompt::invalidateCwd();
+
         return {true, {}};
     }
 
@@ -0,0 +1,134 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\execution\Channel.cpp
+// PURPOSE: Bounded lock-free byte channel between built-in pipeline stages.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <cstring>
+
+#include <windows.h>
+
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress, WakeByAddress*
+
+#include "Channel.hpp"
+
+namespace Execution
+{
+    Channel::Channel(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+
+        m_buffer = std::make_unique<uint8_t[]>(size);
+        m_mask = size - 1;
+    }
+
+    bool Channel::write(const void *data, size_t size)
+    {
+        const auto *src = static_cast<const uint8_t *>(data);
+        const size_t capacity = m_mask + 1;
+
+        size_t head = m_head.load(std::memory_order_relaxed); // only this side moves head
+
+        while (size > 0)
+        {
+            size_t tail = m_tail.load(std::memory_order_acquire);
+
+            if (tail & CLOSED_BIT)
+                return false; // downstream is gone: cancel
+
+            const size_t space = capacity - (head - tail);
+            if (space == 0)
+            {
+                WaitOnAddress(&m_tail, &tail, sizeof(tail), INFINITE); // backpressure
+                continue;
+            }
+
+            const size_t n = std::min(space, size);
+            const size_t offset = head & m_mask;
+            const size_t first = std::min(n, capacity - offset);
+
+            std::memcpy(m_buffer.get() + offset, src, first);
+            std::memcpy(m_buffer.get(), src + first, n - first);
+
+            head += n;
+            src += n;
+            size -= n;
+
+            m_head.store(head, std::memory_order_release);
+            WakeByAddressSingle(&m_head);
+        }
+
+        return true;
+    }
+
+    size_t Channel::read(void *data, size_t size)
+    {
+        auto *dst = static_cast<uint8_t *>(data);
+        const size_t capacity = m_mask + 1;
+
+        size_t tail = m_tail.load(std::memory_order_relaxed); // only this side moves tail
+
+        if ((tail & CLOSED_BIT) || size == 0)
+            return 0;
+
+        while (true)
+        {
+            size_t head = m_head.load(std::memory_order_acquire);
+            const size_t available = (head & ~CLOSED_BIT) - tail;
+
+            if (available > 0)
+            {
+                const size_t n = std::min(available, size);
+                const size_t offset = tail & m_mask;
+                const size_t first = std::min(n, capacity - offset);
+
+                std::memcpy(dst, m_buffer.get() + offset, first);
+                std::memcpy(dst + first, m_buffer.get(), n - first);
+
+                m_tail.store(tail + n, std::memory_order_release);
+                WakeByAddressSingle(&m_tail);
+                return n;
+            }
+
+            if (head & CLOSED_BIT)
+                return 0; // drained and the writer is done
+
+            WaitOnAddress(&m_head, &head, sizeof(head), INFINITE);
+        }
+    }
+
+    void Channel::closeWrite()
+    {
+        m_head.fetch_or(CLOSED_BIT, std::memory_order_release);
+        WakeByAddressAll(&m_head);
+    }
+
+    void Channel::closeRead()
+    {
+        m_tail.fetch_or(CLOSED_BIT, std::memory_order_release);
+        WakeByAddressAll(&m_tail);
+    }
+
+    bool Channel::readerClosed() const
+    {
+        return m_tail.load(std::memory_order_acquire) & CLOSED_BIT;
+    }
+}
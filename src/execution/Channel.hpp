@@ -0,0 +1,91 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\execution\Channel.hpp
+// PURPOSE: Header file for 'src\execution\Channel.cpp'. Connects built-in pipeline stages inside esh.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Execution
+{
+    /**
+     * @class Channel
+     * @brief Bounded single-producer/single-consumer byte channel.
+     *
+     * Connects two built-in stages running as threads in the same pipeline,
+     * so no pipe or process is needed between them. The ring buffer is
+     * lock-free; a full buffer blocks the writer and an empty one blocks the
+     * reader (WaitOnAddress), which gives backpressure.
+     *
+     * Either side can close its end. Closing the read end makes further
+     * writes fail, which is how a finished downstream stage (e.g. 'head')
+     * cancels the stages feeding it.
+     */
+    class Channel
+    {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        /**
+         * @param capacity Buffer size in bytes, rounded up to a power of two.
+         */
+        explicit Channel(size_t capacity = DEFAULT_CAPACITY);
+
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        /**
+         * @brief Writes all bytes, blocking while the buffer is full.
+         *
+         * @return false if the reader closed its end (nothing more will be read).
+         */
+        bool write(const void *data, size_t size);
+
+        /**
+         * @brief Reads at least one byte, blocking while the buffer is empty.
+         *
+         * @return Number of bytes read; 0 once the writer closed and the buffer is drained.
+         */
+        size_t read(void *data, size_t size);
+
+        /** @brief Marks the end of the data. Called by the producer when it finishes. */
+        void closeWrite();
+
+        /** @brief Stops reading. Called by the consumer when it finishes, possibly early. */
+        void closeRead();
+
+        bool readerClosed() const;
+
+    private:
+        // The top bit of each counter is its side's "closed" flag. Closing
+        // therefore changes the value the other side waits on, so a close
+        // can never be missed between a check and WaitOnAddress.
+        static constexpr size_t CLOSED_BIT = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+        std::unique_ptr<uint8_t[]> m_buffer;
+        size_t m_mask;
+
+        alignas(64) std::atomic<size_t> m_head{0}; ///< Bytes written so far (producer)
+        alignas(64) std::atomic<size_t> m_tail{0}; ///< Bytes read so far (consumer)
+    };
+}
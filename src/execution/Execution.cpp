@@ -19,364 +19,530 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
 #include <windows.h>
 
 #include "Execution.hpp"
-#include "../headers/Parser.hpp"
+#include "Channel.hpp"
 #include "../headers/Engine.hpp"
+#include "../headers/Console.hpp"
+#include "../headers/Error.hpp"
+#include "../headers/Unicode.hpp"
+#include "../process/Jobs.hpp"
 
 // HELPER FUNCTIONS
 
-static std::wstring buildCommandLine(const std::vector<Lexer::Token> &tokens)
+/// @brief Appends one argument to a command line, quoting it the way CommandLineToArgvW splits it.
+static void appendArgument(std::wstring &cmdLine, const std::wstring &arg)
 {
-    std::wstring result;
+    if (!cmdLine.empty())
+        cmdLine += L' ';
 
-    for (const auto &t : tokens)
+    if (!arg.empty() && arg.find_first_of(L" \t\n\v\"") == std::wstring::npos)
     {
-        if (!result.empty())
-            result += L" ";
-
-        result += t.lexeme;
+        cmdLine += arg;
+        return;
     }
 
-    return result;
-}
-
-static std::vector<Lexer::Token> stripRedirectionTokens(const std::vector<Lexer::Token> &tokens)
-{
-    std::vector<Lexer::Token> clean;
-
-    for (size_t i = 0; i < tokens.size(); ++i)
+    cmdLine += L'"';
+    for (auto it = arg.begin();; ++it)
     {
-        if (Execution::Executor::getRedirectType(tokens[i]) != Execution::Executor::RedirectType::NONE)
+        size_t backslashes = 0;
+        while (it != arg.end() && *it == L'\\')
         {
-            ++i;
-            continue;
+            ++it;
+            ++backslashes;
         }
-        clean.push_back(tokens[i]);
-    }
-    return clean;
-}
 
-// FUNCTIONS
-
-/**
- * @brief Executes a simple command without pipelines or redirections.
- *
- * Converts a token vector into command type, flags, and arguments,
- * then forwards them to the Engine for execution.
- *
- * @param tokens Tokenized user input.
- * @param ctx    Execution context, including redirection/pipeline state.
- */
-void Execution::Executor::executeSimple(const std::vector<Lexer::Token> &tokens, Context &ctx)
-{
-    uint8_t command = 0;
-    uint8_t flags = 0;
-    std::vector<std::wstring> args;
+        if (it == arg.end())
+        {
+            cmdLine.append(backslashes * 2, L'\\'); // keep them literal before the closing quote
+            break;
+        }
 
-    for (const auto &t : tokens)
-    {
-        if (t.type == Lexer::TOKEN_COMMAND)
-            command = static_cast<uint8_t>(Parser::parseCommand(t.lexeme));
-        else if (t.type == Lexer::TOKEN_FLAG)
-            flags |= Parser::parseFlags({t.lexeme});
+        if (*it == L'"')
+            cmdLine.append(backslashes * 2 + 1, L'\\');
         else
-            args.push_back(t.lexeme);
-    }
+            cmdLine.append(backslashes, L'\\');
 
-    if (command != 0)
-    {
-        Engine::execute(
-            static_cast<CommandType>(command),
-            flags,
-            args, ctx);
+        cmdLine += *it;
     }
+    cmdLine += L'"';
 }
 
-/**
- * @brief Runs a command, handling pipelines and redirections if present.
- *
- * This is the main execution entry point. It detects if a pipeline
- * or I/O redirection exists and dispatches accordingly.
- *
- * @param tokens Tokenized user input.
- * @param ctx    Execution context with standard handles and flags.
- */
-void Execution::Executor::run(const std::vector<Lexer::Token> &tokens, Context &ctx)
+/// @brief Rebuilds the command line a pipeline stage is started with.
+static std::wstring buildCommandLine(const Ast::Command &command)
 {
-    const auto redir = hasRedirection(tokens);
+    std::wstring result;
 
-    if (!hasPipeline(tokens) && !redir.hasRedirection)
+    if (command.isBuiltin())
     {
-        ctx.pipelineEnabled = false;
-        ctx.redirectionEnabled = false;
+        appendArgument(result, std::wstring(commandName(command.builtin)));
 
-        executeSimple(tokens, ctx);
-        return;
-    }
-    else if (hasPipeline(tokens))
-    {
-        ctx.pipelineEnabled = true;
-        executePipeline(tokens);
+        for (const auto &flag : flagEntries)
+        {
+            if (command.flags & static_cast<uint16_t>(flag.value))
+                appendArgument(result, std::wstring(flag.key));
+        }
     }
-    else if (redir.hasRedirection)
-    {
-        ctx.redirectionEnabled = true;
 
-        auto redirInfo = parseRedirections(tokens);
-        auto cleanTokens = stripRedirectionTokens(tokens);
+    for (const auto &arg : command.args)
+        appendArgument(result, arg);
 
-        HANDLE oldIn = ctx.stdinHandle;
-        HANDLE oldOut = ctx.stdoutHandle;
-        HANDLE oldErr = ctx.stderrHandle;
+    return result;
+}
 
-        if (redirInfo.stdinHandle)
-            ctx.stdinHandle = redirInfo.stdinHandle;
+/// @brief Writes text to a handle: UTF-16 for a console, UTF-8 for files and pipes.
+static bool writeHandle(HANDLE h, DWORD fallback, const std::wstring &text)
+{
+    if (h == INVALID_HANDLE_VALUE || h == nullptr)
+        h = GetStdHandle(fallback);
 
-        if (redirInfo.stdoutHandle)
-            ctx.stdoutHandle = redirInfo.stdoutHandle;
+    DWORD written = 0;
+    DWORD mode;
 
-        if (redirInfo.stderrHandle)
-            ctx.stderrHandle = redirInfo.stderrHandle;
+    if (GetConsoleMode(h, &mode))
+        return WriteConsoleW(h, text.c_str(), static_cast<DWORD>(text.size()), &written, nullptr);
 
-        executeSimple(cleanTokens, ctx);
+    std::string utf8 = unicode::utf16_to_utf8(text);
+    return WriteFile(h, utf8.data(), static_cast<DWORD>(utf8.size()), &written, nullptr); // fails once the reader exited
+}
 
-        ctx.stdinHandle = oldIn;
-        ctx.stdoutHandle = oldOut;
-        ctx.stderrHandle = oldErr;
+/// @brief Makes a handle inheritable just before it is passed to a child process.
+static void inheritable(HANDLE h)
+{
+    if (h && h != INVALID_HANDLE_VALUE)
+        SetHandleInformation(h, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT);
+}
 
-        if (redirInfo.stdinHandle)
-            CloseHandle(redirInfo.stdinHandle);
+/// @brief Text shown for a pipeline in the job table.
+static std::wstring describePipeline(const Ast::Pipeline &pipeline)
+{
+    std::wstring result;
 
-        if (redirInfo.stdoutHandle && redirInfo.stdoutHandle != redirInfo.stderrHandle)
-            CloseHandle(redirInfo.stdoutHandle);
+    for (const auto &command : pipeline.commands)
+    {
+        if (!result.empty())
+            result += L" | ";
 
-        if (redirInfo.stderrHandle)
-            CloseHandle(redirInfo.stderrHandle);
+        result += buildCommandLine(command);
     }
+
+    if (pipeline.background)
+        result += L" &";
+
+    return result;
 }
 
-/**
- * @brief Determines if the token list contains a pipeline operator '|'.
- *
- * @param tokens Tokenized input.
- * @return true if a pipeline is detected, false otherwise.
- */
-bool Execution::Executor::hasPipeline(const std::vector<Lexer::Token> &tokens)
+/// @brief Wall clock and CPU times of the calling thread, used to time built-in stages.
+struct ThreadClock
 {
+    std::chrono::steady_clock::time_point wall;
+    uint64_t user = 0;
+    uint64_t kernel = 0;
+};
 
-    for (const auto &t : tokens)
+/// @brief Reads the calling thread's clocks.
+static ThreadClock readThreadClock()
+{
+    ThreadClock clock;
+    clock.wall = std::chrono::steady_clock::now();
+
+    FILETIME creation, exit, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
     {
-        if (t.type == Lexer::TOKEN_PIPELINE && t.lexeme == L"|") // double check
-        {
-            return true;
-        }
+        clock.user = ((static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime) / 10;
+        clock.kernel = ((static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime) / 10;
     }
 
-    return false;
+    return clock;
+}
+
+/// @brief Stores the time a built-in stage took since `start` and its exit status.
+static void finishBuiltinStage(Process::StageStatus &status, const ThreadClock &start, DWORD exitCode)
+{
+    ThreadClock now = readThreadClock();
+
+    status.started = true;
+    status.exitCode = exitCode;
+    status.wallMicros = std::chrono::duration_cast<std::chrono::microseconds>(now.wall - start.wall).count();
+    status.userMicros = now.user - start.user;
+    status.kernelMicros = now.kernel - start.kernel;
 }
 
+// FUNCTIONS
+
 /**
- * @brief Checks for redirection tokens in the input.
+ * @brief Executes a single built-in command.
  *
- * @param tokens Tokenized input.
- * @return Redirection struct containing flag and operator string.
+ * Applies the command's redirections to the context, forwards the command
+ * type, flags, and arguments to the Engine, then restores the context.
+ *
+ * @param command Parsed built-in command.
+ * @param ctx     Execution context, including redirection/pipeline state.
  */
-Execution::Executor::Redirection Execution::Executor::hasRedirection(const std::vector<Lexer::Token> &tokens)
+void Execution::Executor::executeSimple(const Ast::Command &command, Context &ctx)
 {
-    for (const auto &t : tokens)
+    ctx.exitCode = 0;
+
+    std::vector<Process::StageStatus> status(1);
+    status[0].command = buildCommandLine(command);
+    status[0].builtin = true;
+
+    // 'fg' and 'wait' record the job they waited for; 'pipestat' must not hide what it reports
+    const bool records = command.builtin != CommandType::PIPESTAT &&
+                         command.builtin != CommandType::FG &&
+                         command.builtin != CommandType::WAIT;
+    const ThreadClock start = readThreadClock();
+
+    if (command.redirections.empty())
     {
-        if (t.type == Lexer::TOKEN_OUTPUT_REDIRECTION_ONE ||
-            t.type == Lexer::TOKEN_OUTPUT_REDIRECTION_TWO ||
-            t.type == Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_ONE ||
-            t.type == Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO ||
-            t.type == Lexer::TOKEN_ERROR_REDIRECTION_ONE ||
-            t.type == Lexer::TOKEN_ERROR_REDIRECTION_TWO)
+        Engine::execute(command.builtin, command.flags, command.args, ctx);
+        ctx.output.flush();
+
+        if (records)
         {
-            return {true, t.lexeme};
+            finishBuiltinStage(status[0], start, ctx.exitCode);
+            Process::JobTable::instance().recordStatus(std::move(status));
         }
+        return;
     }
 
-    return {false, L""};
+    auto redirInfo = openRedirections(command.redirections);
+
+    HANDLE oldIn = ctx.stdinHandle;
+    HANDLE oldOut = ctx.stdoutHandle;
+    HANDLE oldErr = ctx.stderrHandle;
+
+    if (redirInfo.stdinHandle)
+        ctx.stdinHandle = redirInfo.stdinHandle;
+
+    if (redirInfo.stdoutHandle)
+        ctx.stdoutHandle = redirInfo.stdoutHandle;
+
+    if (redirInfo.stderrHandle)
+        ctx.stderrHandle = redirInfo.stderrHandle;
+
+    Engine::execute(command.builtin, command.flags, command.args, ctx);
+    ctx.output.flush(); // before the redirected handles are closed
+
+    ctx.stdinHandle = oldIn;
+    ctx.stdoutHandle = oldOut;
+    ctx.stderrHandle = oldErr;
+
+    closeRedirections(redirInfo);
+
+    if (records)
+    {
+        finishBuiltinStage(status[0], start, ctx.exitCode);
+        Process::JobTable::instance().recordStatus(std::move(status));
+    }
 }
 
 /**
- * @brief Splits a token list into multiple commands separated by '|'.
+ * @brief Runs a parsed plan.
  *
- * @param tokens Tokenized input.
- * @return Vector of token vectors, each representing a command.
+ * This is the main execution entry point. The plan has already been
+ * validated by the parser, so pipelines and redirections are known up
+ * front and no token rescanning is needed.
+ *
+ * @param plan Parsed command sequence.
+ * @param ctx  Execution context with standard handles and flags.
  */
-std::vector<std::vector<Lexer::Token>> Execution::Executor::splitByPipeline(const std::vector<Lexer::Token> &tokens)
+void Execution::Executor::run(const Ast::Sequence &plan, Context &ctx)
 {
-    std::vector<std::vector<Lexer::Token>> result;
-    result.emplace_back();
-
-    for (const auto &t : tokens)
+    for (const auto &pipeline : plan.pipelines)
     {
-        if (t.type == Lexer::TOKEN_PIPELINE)
-        {
-            result.emplace_back();
-        }
+        const bool single = pipeline.commands.size() == 1;
+
+        ctx.pipelineEnabled = !single;
+        ctx.redirectionEnabled = single && !pipeline.commands.front().redirections.empty();
+
+        if (single && pipeline.commands.front().isBuiltin() && !pipeline.background)
+            executeSimple(pipeline.commands.front(), ctx);
         else
-        {
-            result.back().push_back(t);
-        }
+            executePipeline(pipeline, ctx);
     }
-
-    return result;
 }
 
 /**
  * @brief Executes a sequence of piped commands.
  *
- * Creates pipes between processes and handles I/O redirection for each.
+ * Built-in stages run as threads inside esh. Two neighbouring built-ins
+ * are connected by a Channel; a real pipe is only created where an
+ * external process sits on one side. External processes are started
+ * suspended and put into the job's job object. A foreground pipeline is
+ * waited for; a background one ('&') returns immediately and reads from NUL.
  *
- * @param tokens Tokenized input containing pipelines and optional redirections.
+ * @param pipeline Parsed pipeline.
+ * @param ctx      Execution context; receives the exit status.
  */
-void Execution::Executor::executePipeline(const std::vector<Lexer::Token> &tokens)
+void Execution::Executor::executePipeline(const Ast::Pipeline &pipeline, Context &ctx)
 {
-    auto commands = splitByPipeline(tokens);
+    const auto &commands = pipeline.commands;
+
+    ctx.exitCode = 0;
+
+    auto &jobs = Process::JobTable::instance();
+    auto &job = jobs.create(describePipeline(pipeline), pipeline.background);
+
+    job.stages.resize(commands.size());
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        job.stages[i].command = buildCommandLine(commands[i]);
+        job.stages[i].builtin = commands[i].isBuiltin();
+    }
 
-    HANDLE prevRead = NULL;
+    // Link from the previous stage: a channel between two built-ins, otherwise a pipe
+    std::shared_ptr<Channel> prevChannel;
+    HANDLE prevRead = nullptr;
 
     for (size_t i = 0; i < commands.size(); ++i)
     {
-        HANDLE readPipe = NULL;
-        HANDLE writePipe = NULL;
+        const auto &command = commands[i];
+        const bool last = i == commands.size() - 1;
 
-        SECURITY_ATTRIBUTES sa{};
-        sa.nLength = sizeof(sa);
-        sa.lpSecurityDescriptor = nullptr;
-        sa.bInheritHandle = TRUE;
+        std::shared_ptr<Channel> outChannel;
+        HANDLE readPipe = nullptr;
+        HANDLE writePipe = nullptr;
 
-        if (i < commands.size() - 1) // don't need pipeline for the last command
+        if (!last) // don't need pipeline for the last command
         {
-            CreatePipe(&readPipe, &writePipe, &sa, 0);
+            if (command.isBuiltin() && commands[i + 1].isBuiltin())
+            {
+                outChannel = std::make_shared<Channel>();
+            }
+            else
+            {
+                // Not inheritable: only the end an external process uses is made so, right before it starts
+                SECURITY_ATTRIBUTES sa{};
+                sa.nLength = sizeof(sa);
+                sa.lpSecurityDescriptor = nullptr;
+                sa.bInheritHandle = FALSE;
+
+                CreatePipe(&readPipe, &writePipe, &sa, 0);
+            }
         }
 
-        STARTUPINFOW si{};
-        si.cb = sizeof(si);
-        si.dwFlags = STARTF_USESTDHANDLES;
+        auto redir = openRedirections(command.redirections);
 
-        si.hStdInput = prevRead ? prevRead : GetStdHandle(STD_INPUT_HANDLE);
-        si.hStdOutput = (i < commands.size() - 1)
-                            ? writePipe
-                            : GetStdHandle(STD_OUTPUT_HANDLE);
-        si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+        // STDIN (nullptr means the console)
+        if (!redir.stdinHandle && i == 0 && pipeline.background)
+            redir.stdinHandle = openFileForRead(L"NUL"); // a background job must not compete with the shell for console input
 
-        auto redir = parseRedirections(commands[i]);
-
-        // STDIN
-        if (i == 0 && redir.stdinHandle)
-        {
-            si.hStdInput = redir.stdinHandle;
-        }
-        else if (prevRead)
-        {
-            si.hStdInput = prevRead;
-        }
+        HANDLE in = redir.stdinHandle ? redir.stdinHandle : prevRead;
 
         // STDOUT
-        if (i < commands.size() - 1)
-        {
-            si.hStdOutput = writePipe;
-        }
-        else
+        HANDLE out = redir.stdoutHandle ? redir.stdoutHandle : writePipe;
+
+        if (command.isBuiltin())
         {
-            si.hStdOutput = redir.stdoutHandle
-                                ? redir.stdoutHandle
-                                : GetStdHandle(STD_OUTPUT_HANDLE);
+            Context stage;
+            stage.stdinHandle = in ? in : INVALID_HANDLE_VALUE;
+            stage.stdoutHandle = out ? out : INVALID_HANDLE_VALUE;
+            stage.stderrHandle = redir.stderrHandle ? redir.stderrHandle : INVALID_HANDLE_VALUE;
+            stage.inChannel = redir.stdinHandle ? nullptr : prevChannel.get();
+            stage.outChannel = redir.stdoutHandle ? nullptr : outChannel.get();
+            stage.pipelineEnabled = true;
+            stage.redirectionEnabled = !command.redirections.empty();
+            stage.interrupt = job.interrupt; // the job's own: Ctrl+C at the prompt or in another job must not end it
+
+            jobs.attachStage(job);
+
+            // The thread owns its ends of the links. Closing them when it returns is
+            // what ends the next stage's input and cancels the previous stage.
+            std::thread(
+                [job = job.shared_from_this(), i, command, stage = std::move(stage), redir,
+                 inChannel = prevChannel, outChannel, inPipe = prevRead, outPipe = writePipe]() mutable
+                {
+                    const ThreadClock start = readThreadClock();
+
+                    Engine::execute(command.builtin, command.flags, command.args, stage);
+                    stage.output.flush();
+
+                    if (outChannel)
+                        outChannel->closeWrite();
+                    if (inChannel)
+                        inChannel->closeRead();
+                    if (outPipe)
+                        CloseHandle(outPipe);
+                    if (inPipe)
+                        CloseHandle(inPipe);
+
+                    closeRedirections(redir);
+
+                    // Published to the shell thread by finishOne()
+                    finishBuiltinStage(job->stages[i], start, stage.exitCode);
+
+                    job->finishOne();
+                })
+                .detach();
+
+            prevChannel = std::move(outChannel);
+            prevRead = readPipe;
+            continue;
         }
 
-        // STDERR
-        si.hStdError = redir.stderrHandle
-                           ? redir.stderrHandle
-                           : GetStdHandle(STD_ERROR_HANDLE);
+        STARTUPINFOW si{};
+        si.cb = sizeof(si);
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdInput = in ? in : GetStdHandle(STD_INPUT_HANDLE);
+        si.hStdOutput = out ? out : GetStdHandle(STD_OUTPUT_HANDLE);
+        si.hStdError = redir.stderrHandle ? redir.stderrHandle : GetStdHandle(STD_ERROR_HANDLE);
+
+        inheritable(prevRead);
+        inheritable(writePipe);
 
         PROCESS_INFORMATION pi{};
 
-        auto cleanTokens = stripRedirectionTokens(commands[i]);
-        std::wstring cmdLine = buildCommandLine(cleanTokens);
+        std::wstring cmdLine = buildCommandLine(command);
 
         std::vector<wchar_t> buffer(cmdLine.begin(), cmdLine.end());
         buffer.push_back(L'\0');
 
-        CreateProcessW(
-            nullptr,
-            buffer.data(),
-            nullptr,
-            nullptr,
-            TRUE,
-            0,
-            nullptr,
-            nullptr,
-            &si,
-            &pi);
-
-        CloseHandle(pi.hThread);
-        CloseHandle(pi.hProcess);
+        if (!CreateProcessW(
+                nullptr,
+                buffer.data(),
+                nullptr,
+                nullptr,
+                TRUE,
+                CREATE_SUSPENDED | (pipeline.background ? CREATE_NEW_PROCESS_GROUP : 0),
+                nullptr,
+                nullptr,
+                &si,
+                &pi))
+        {
+            Error err = makeLastError(L"esh: " + cmdLine);
+            console::setColor(ConsoleColor::Red);
+            std::wcerr << err.message; // FormatMessage text ends with a newline
+            console::reset();
+
+            job.stages[i].exitCode = 127; // command not found / not executable
 
+            if (last)
+                ctx.exitCode = 127;
+        }
+        else
+        {
+            jobs.attachProcess(job, pi.hProcess);
+
+            job.stages[i].process = pi.hProcess;
+            job.stages[i].started = true;
+
+            ResumeThread(pi.hThread);
+            CloseHandle(pi.hThread);
+        }
+
+        // The child has its own copies now
         if (prevRead)
             CloseHandle(prevRead);
 
         if (writePipe)
             CloseHandle(writePipe);
 
+        prevChannel.reset();
         prevRead = readPipe;
 
-        if (redir.stdinHandle)
-            CloseHandle(redir.stdinHandle);
+        closeRedirections(redir);
+    }
+
+    jobs.launched(job);
 
-        if (redir.stdoutHandle && redir.stdoutHandle != redir.stderrHandle)
-            CloseHandle(redir.stdoutHandle);
+    if (pipeline.background)
+    {
+        std::wstring line = L"[" + std::to_wstring(job.id) + L"]";
 
-        if (redir.stderrHandle)
-            CloseHandle(redir.stderrHandle);
+        if (!job.processes.empty())
+            line += L" " + std::to_wstring(GetProcessId(job.processes.back()));
+
+        console::writeln(line);
+        return;
     }
+
+    DWORD status = jobs.waitForeground(job);
+
+    if (ctx.exitCode == 0)
+        ctx.exitCode = status;
 }
 
 /**
- * @brief Returns the type of redirection a token represents.
+ * @brief Writes a built-in's output to its channel, pipe, file or the console.
  *
- * @param t Token to inspect.
- * @return RedirectType enum corresponding to STDIN, STDOUT, STDERR, or NONE.
+ * @param ctx  Execution context of the built-in.
+ * @param text Output text.
+ * @return false if the reader has gone away.
  */
-Execution::Executor::RedirectType Execution::Executor::getRedirectType(const Lexer::Token &t)
+bool Execution::Executor::writeOutput(Context &ctx, const std::wstring &text)
 {
-    switch (t.type)
-    {
-    case Lexer::TOKEN_INPUT_REDIRECTION:
-        return Execution::Executor::RedirectType::STDIN;
+    ctx.output.bind(ctx.outChannel, ctx.stdoutHandle);
+    return ctx.output.write(text);
+}
 
-    case Lexer::TOKEN_OUTPUT_REDIRECTION_ONE: // >
-    case Lexer::TOKEN_OUTPUT_REDIRECTION_TWO: // >>
-        return Execution::Executor::RedirectType::STDOUT;
+/**
+ * @brief Writes a built-in's UTF-8 output to its channel, pipe, file or the console.
+ *
+ * @param ctx  Execution context of the built-in.
+ * @param data UTF-8 bytes.
+ * @param size Number of bytes.
+ * @return false if the reader has gone away.
+ */
+bool Execution::Executor::writeBytes(Context &ctx, const char *data, size_t size)
+{
+    ctx.output.bind(ctx.outChannel, ctx.stdoutHandle);
+    return ctx.output.write(data, size);
+}
 
-    case Lexer::TOKEN_ERROR_REDIRECTION_ONE: // 2>
-    case Lexer::TOKEN_ERROR_REDIRECTION_TWO: // 2>>
-        return Execution::Executor::RedirectType::STDERR;
+/**
+ * @brief Writes out a built-in's buffered output.
+ *
+ * @param ctx Execution context of the built-in.
+ * @return false if the reader has gone away.
+ */
+bool Execution::Executor::flushOutput(Context &ctx)
+{
+    return ctx.output.flush();
+}
 
-    case Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_ONE: // &>
-    case Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO: // &>>
-        return Execution::Executor::RedirectType::STDOUT_STDERR;
+/**
+ * @brief Writes a built-in's error message and sets its exit status to 1.
+ *
+ * @param ctx  Execution context of the built-in.
+ * @param text Error message.
+ */
+void Execution::Executor::writeError(Context &ctx, const std::wstring &text)
+{
+    ctx.exitCode = 1;
+    ctx.output.flush(); // keep the order when both go to the same place
 
-    default:
-        return Execution::Executor::RedirectType::NONE;
-    }
+    if (!text.empty() && text.back() == L'\n')
+        writeHandle(ctx.stderrHandle, STD_ERROR_HANDLE, text);
+    else
+        writeHandle(ctx.stderrHandle, STD_ERROR_HANDLE, text + L"\n");
 }
 
 /**
- * @brief Determines if a redirection token indicates append mode.
+ * @brief Reads a built-in's input from the previous stage's channel or from stdin.
  *
- * @param t Token to inspect.
- * @return true if the redirection appends, false otherwise.
+ * @param ctx    Execution context of the built-in.
+ * @param buffer Destination buffer.
+ * @param size   Buffer size in bytes.
+ * @return Number of bytes read; 0 at end of input.
  */
-bool Execution::Executor::isAppendRedirection(const Lexer::Token &t)
+DWORD Execution::Executor::readInput(Context &ctx, void *buffer, DWORD size)
 {
-    return t.type == Lexer::TOKEN_OUTPUT_REDIRECTION_TWO ||
-           t.type == Lexer::TOKEN_ERROR_REDIRECTION_TWO ||
-           t.type == Lexer::TOKEN_OUTPUT_ERROR_REDIRECTION_TWO;
+    if (ctx.inChannel)
+        return static_cast<DWORD>(ctx.inChannel->read(buffer, size));
+
+    HANDLE h = ctx.stdinHandle;
+    if (h == INVALID_HANDLE_VALUE || h == nullptr)
+        h = GetStdHandle(STD_INPUT_HANDLE);
+
+    DWORD read = 0;
+    return ReadFile(h, buffer, size, &read, nullptr) ? read : 0;
 }
 
 /**
@@ -435,70 +601,91 @@ HANDLE Execution::Executor::openFileForRead(const std::wstring &path)
 }
 
 /**
- * @brief Parses tokenized input and extracts redirection handles.
+ * @brief Opens the files named by a command's redirections.
  *
- * Generates a RedirectionInfo struct containing handles for STDIN,
- * STDOUT, and STDERR according to the redirection tokens in the input.
+ * Later redirections of the same stream replace earlier ones. '2>&1'
+ * makes stderr share whatever stdout ends up pointing at.
  *
- * @param tokens Tokenized input.
+ * @param redirections Redirections of a single command.
  * @return RedirectionInfo with opened handles.
  */
-Execution::Executor::RedirectionInfo Execution::Executor::parseRedirections(const std::vector<Lexer::Token> &tokens)
+Execution::Executor::RedirectionInfo Execution::Executor::openRedirections(const std::vector<Ast::Redirection> &redirections)
 {
     Execution::Executor::RedirectionInfo info;
 
-    for (size_t i = 0; i + 1 < tokens.size(); ++i)
+    for (const auto &r : redirections)
     {
-        Execution::Executor::RedirectType type = getRedirectType(tokens[i]);
-        if (type == Execution::Executor::RedirectType::NONE)
-            continue;
-
-        const std::wstring &target = tokens[i + 1].lexeme;
-        bool append = Execution::Executor::isAppendRedirection(tokens[i]);
-
-        switch (type)
+        switch (r.type)
         {
-        case Execution::Executor::RedirectType::STDIN:
+        case RedirectType::STDIN:
 
             if (info.stdinHandle)
                 CloseHandle(info.stdinHandle);
 
-            info.stdinHandle = Execution::Executor::openFileForRead(target);
+            info.stdinHandle = Execution::Executor::openFileForRead(r.target);
             break;
 
-        case Execution::Executor::RedirectType::STDOUT:
+        case RedirectType::STDOUT:
 
-            if (info.stdoutHandle)
+            if (info.stdoutHandle && info.stdoutHandle != info.stderrHandle)
                 CloseHandle(info.stdoutHandle);
 
-            info.stdoutHandle = Execution::Executor::openFileForWrite(target, append);
+            info.stdoutHandle = Execution::Executor::openFileForWrite(r.target, r.append);
             break;
 
-        case Execution::Executor::RedirectType::STDERR:
+        case RedirectType::STDERR:
 
-            if (info.stderrHandle)
+            if (info.stderrHandle && info.stderrHandle != info.stdoutHandle)
                 CloseHandle(info.stderrHandle);
 
-            info.stderrHandle = Execution::Executor::openFileForWrite(target, append);
+            info.stderrHandle = Execution::Executor::openFileForWrite(r.target, r.append);
             break;
 
-        case Execution::Executor::RedirectType::STDOUT_STDERR:
+        case RedirectType::STDOUT_STDERR:
         {
-            HANDLE h = Execution::Executor::openFileForWrite(target, append);
-            if (info.stdoutHandle)
-                CloseHandle(info.stdoutHandle);
-            if (info.stderrHandle)
-                CloseHandle(info.stderrHandle);
-                
+            HANDLE h = Execution::Executor::openFileForWrite(r.target, r.append);
+            closeRedirections({nullptr, info.stdoutHandle, info.stderrHandle});
+
             info.stdoutHandle = h;
             info.stderrHandle = h;
             break;
         }
 
+        case RedirectType::STDERR_TO_STDOUT:
+            info.errorToOutput = true;
+            break;
+
         default:
             break;
         }
     }
 
+    // 2>&1: stderr goes wherever stdout ended up. Without an stdout
+    // redirection both already share the console, so nothing changes.
+    if (info.errorToOutput && info.stdoutHandle && info.stderrHandle != info.stdoutHandle)
+    {
+        if (info.stderrHandle)
+            CloseHandle(info.stderrHandle);
+
+        info.stderrHandle = info.stdoutHandle;
+    }
+
     return info;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Closes the handles opened by openRedirections.
+ *
+ * @param info Handles to close. A handle shared by stdout and stderr is closed once.
+ */
+void Execution::Executor::closeRedirections(const RedirectionInfo &info)
+{
+    if (info.stdinHandle)
+        CloseHandle(info.stdinHandle);
+
+    if (info.stdoutHandle && info.stdoutHandle != info.stderrHandle)
+        CloseHandle(info.stdoutHandle);
+
+    if (info.stderrHandle)
+        CloseHandle(info.stderrHandle);
+}
@@ -27,29 +27,24 @@ limitations under the License.
 #include <windows.h>
 
 #include "../headers/Lexer.hpp"
+#include "../headers/Ast.hpp"
+#include "OutputSink.hpp"
 
 namespace Execution
 {
+    class Channel;
+
     /**
      * @class Executor
      * @brief Handles command execution, including pipelines and I/O redirections.
      *
-     * This class provides static functions for executing tokenized shell commands,
-     * managing pipelines, and handling input/output redirections on Windows.
+     * This class provides static functions for executing parsed shell plans
+     * (see Ast.hpp), managing pipelines, and handling input/output
+     * redirections on Windows.
      */
     class Executor
     {
     public:
-        /**
-         * @struct Redirection
-         * @brief Indicates whether a command contains a redirection token.
-         */
-        struct Redirection
-        {
-            bool hasRedirection;            ///< True if any redirection exists
-            std::wstring redirectionString; ///< Redirection operator string (>, >>, 2>, etc.)
-        };
-
         /**
          * @struct RedirectionInfo
          * @brief Stores opened HANDLEs for standard input, output, and error.
@@ -59,20 +54,10 @@ namespace Execution
             HANDLE stdinHandle = nullptr;  ///< Handle for redirected input
             HANDLE stdoutHandle = nullptr; ///< Handle for redirected output
             HANDLE stderrHandle = nullptr; ///< Handle for redirected error
+            bool errorToOutput = false;    ///< True if '2>&1' was given
         };
 
-        /**
-         * @enum RedirectType
-         * @brief Type of redirection a token represents.
-         */
-        enum class RedirectType
-        {
-            NONE,         ///< No redirection
-            STDIN,        ///< Input redirection '<'
-            STDOUT,       ///< Output redirection '>' or '>>'
-            STDERR,       ///< Error redirection '2>' or '2>>'
-            STDOUT_STDERR ///< Combined output and error '&>' or '&>>'
-        };
+        using RedirectType = Ast::RedirectType;
 
         /**
          * @struct Context
@@ -86,76 +71,94 @@ namespace Execution
 
             bool pipelineEnabled = false;    ///< True if executing in a pipeline
             bool redirectionEnabled = false; ///< True if any redirection is active
+
+            DWORD exitCode = 0; ///< Exit status of the last command run with this context
+
+            Channel *inChannel = nullptr;  ///< Input from the previous built-in stage, if any
+            Channel *outChannel = nullptr; ///< Output to the next built-in stage, if any
+
+            HANDLE interrupt = nullptr; ///< Set by Ctrl+C while in the foreground; built-ins that run until stopped wait on it (may be null)
+
+            OutputSink output; ///< Standard output of the built-in, bound to outChannel or stdoutHandle on each write
         };
 
         /**
-         * @brief Main entry point for executing a tokenized command.
+         * @brief Writes a built-in's output to wherever its stdout points.
          *
-         * Detects pipelines and redirections, then dispatches the appropriate execution path.
+         * Goes to the next stage's channel, a pipe or file (as UTF-8), or the
+         * console (as UTF-16).
          *
-         * @param tokens Tokenized command input.
-         * @param ctx    Execution context including standard handles and flags.
+         * @return false if the reader has gone away; the built-in should stop producing.
          */
-        static void run(const std::vector<Lexer::Token> &tokens, Context &ctx);
+        static bool writeOutput(Context &ctx, const std::wstring &text);
 
         /**
-         * @brief Checks if a pipeline '|' exists in the token list.
+         * @brief Writes UTF-8 output without converting it first.
          *
-         * @param tokens Tokenized input.
-         * @return true if pipeline exists; false otherwise.
+         * Channels, pipes and files get the bytes unchanged; only the console
+         * is given UTF-16. A character split between two writes is joined
+         * again (see OutputSink).
+         *
+         * @return false if the reader has gone away.
          */
-        static bool hasPipeline(const std::vector<Lexer::Token> &tokens);
+        static bool writeBytes(Context &ctx, const char *data, size_t size);
 
         /**
-         * @brief Checks if any redirection tokens exist in the token list.
+         * @brief Writes out buffered output now.
+         *
+         * Done when a built-in returns; built-ins that keep running (such as
+         * 'tail -f') call it whenever they wait.
          *
-         * @param tokens Tokenized input.
-         * @return Redirection struct with existence flag and operator.
+         * @return false if the reader has gone away.
          */
-        static Redirection hasRedirection(const std::vector<Lexer::Token> &tokens);
+        static bool flushOutput(Context &ctx);
 
         /**
-         * @brief Executes a command without pipelines or redirections.
+         * @brief Writes a built-in's error message and marks the command as failed.
          *
-         * Converts tokens into command, flags, and arguments, and forwards them to Engine::execute.
-         *
-         * @param tokens Tokenized command input.
-         * @param ctx    Execution context.
+         * A trailing newline is added if the message has none.
          */
-        static void executeSimple(const std::vector<Lexer::Token> &tokens, Context &ctx);
+        static void writeError(Context &ctx, const std::wstring &text);
 
         /**
-         * @brief Executes multiple commands connected via pipeline.
+         * @brief Reads a built-in's input from the previous stage or stdin.
          *
-         * Sets up pipes between processes and handles I/O appropriately.
-         *
-         * @param tokens Tokenized command input containing '|' operators.
+         * @return Number of bytes read; 0 at end of input.
          */
-        static void executePipeline(const std::vector<Lexer::Token> &tokens);
+        static DWORD readInput(Context &ctx, void *buffer, DWORD size);
 
         /**
-         * @brief Splits a token list into separate commands at pipeline tokens.
+         * @brief Main entry point for executing a parsed plan.
+         *
+         * Runs each pipeline of the sequence in order, dispatching single
+         * built-ins directly and everything else through executePipeline.
          *
-         * @param tokens Tokenized command input.
-         * @return Vector of token vectors for each command in the pipeline.
+         * @param plan Parsed command sequence.
+         * @param ctx  Execution context including standard handles and flags.
          */
-        static std::vector<std::vector<Lexer::Token>> splitByPipeline(const std::vector<Lexer::Token> &tokens);
+        static void run(const Ast::Sequence &plan, Context &ctx);
 
         /**
-         * @brief Returns the type of redirection a token represents.
+         * @brief Executes a single built-in command, applying its redirections.
+         *
+         * Forwards the command type, flags, and arguments to Engine::execute.
          *
-         * @param t Token to inspect.
-         * @return RedirectType enum.
+         * @param command Parsed built-in command.
+         * @param ctx     Execution context.
          */
-        static RedirectType getRedirectType(const Lexer::Token &t);
+        static void executeSimple(const Ast::Command &command, Context &ctx);
 
         /**
-         * @brief Checks whether a redirection token indicates append mode.
+         * @brief Executes multiple commands connected via pipeline.
+         *
+         * Built-in stages run as threads connected by channels; pipes are
+         * only created where an external process is on either side. A single
+         * external command is run as a one-stage pipeline.
          *
-         * @param t Token to inspect.
-         * @return true if append redirection (>> or &>>); false otherwise.
+         * @param pipeline Parsed pipeline.
+         * @param ctx      Execution context; receives the exit status.
          */
-        static bool isAppendRedirection(const Lexer::Token &t);
+        static void executePipeline(const Ast::Pipeline &pipeline, Context &ctx);
 
         /**
          * @brief Opens a file handle for writing or appending.
@@ -175,11 +178,18 @@ namespace Execution
         static HANDLE openFileForRead(const std::wstring &path);
 
         /**
-         * @brief Parses redirection tokens and opens file handles accordingly.
+         * @brief Opens the files named by a command's redirections.
          *
-         * @param tokens Tokenized command input.
+         * @param redirections Redirections of a single command.
          * @return RedirectionInfo struct containing opened handles for STDIN, STDOUT, STDERR.
          */
-        static RedirectionInfo parseRedirections(const std::vector<Lexer::Token> &tokens);
+        static RedirectionInfo openRedirections(const std::vector<Ast::Redirection> &redirections);
+
+        /**
+         * @brief Closes the handles opened by openRedirections.
+         *
+         * @param info Handles to close (shared stdout/stderr handles are closed once).
+         */
+        static void closeRedirections(const RedirectionInfo &info);
     };
 }
@@ -0,0 +1,197 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\execution\OutputSink.cpp
+// PURPOSE: Takes a built-in's output as UTF-8 bytes.
+
+// INCLUDE LIBRARIES
+
+#include <windows.h>
+
+#include "../headers/Unicode.hpp"
+#include "Channel.hpp"
+#include "OutputSink.hpp"
+
+// FUNCTIONS
+
+namespace Execution
+{
+    OutputSink::~OutputSink()
+    {
+        flush();
+    }
+
+    void OutputSink::bind(Channel *channel, HANDLE handle)
+    {
+        if (m_bound && channel == m_channel && handle == m_handle)
+            return;
+
+        flush();
+
+        m_channel = channel;
+        m_handle = handle;
+        m_bound = true;
+        m_open = true;
+
+        if (channel)
+        {
+            m_kind = Kind::CHANNEL;
+            return;
+        }
+
+        m_target = (handle && handle != INVALID_HANDLE_VALUE) ? handle : GetStdHandle(STD_OUTPUT_HANDLE);
+
+        DWORD mode;
+        m_kind = GetConsoleMode(m_target, &mode) ? Kind::CONSOLE : Kind::STREAM;
+    }
+
+    bool OutputSink::write(const char *data, size_t size)
+    {
+        if (!m_bound)
+            bind(nullptr, nullptr);
+
+        if (!m_open)
+            return false;
+
+        switch (m_kind)
+        {
+        case Kind::CHANNEL:
+            return m_open = m_channel->write(data, size);
+
+        case Kind::CONSOLE:
+            return writeConsole(data, size);
+
+        default:
+            break;
+        }
+
+        if (m_pending.size() + size <= BUFFER_SIZE)
+        {
+            m_pending.append(data, size);
+            return true;
+        }
+
+        if (!flush())
+            return false;
+
+        if (size >= BUFFER_SIZE)
+            return writeStream(data, size); // large writes skip the copy
+
+        m_pending.assign(data, size);
+        return true;
+    }
+
+    bool OutputSink::write(const std::wstring &text)
+    {
+        if (!m_bound)
+            bind(nullptr, nullptr);
+
+        if (m_kind == Kind::CONSOLE)
+            return flush() && writeConsole(text.data(), text.size());
+
+        std::string utf8 = unicode::utf16_to_utf8(text);
+        return write(utf8.data(), utf8.size());
+    }
+
+    bool OutputSink::flush()
+    {
+        if (m_pending.empty() || !m_open)
+        {
+            m_pending.clear();
+            return m_open;
+        }
+
+        std::string pending;
+        pending.swap(m_pending);
+
+        if (m_kind == Kind::CONSOLE)
+        {
+            // Only an incomplete character is ever held back; let the console show a replacement
+            int length = MultiByteToWideChar(CP_UTF8, 0, pending.data(), static_cast<int>(pending.size()), nullptr, 0);
+            m_wide.resize(static_cast<size_t>(length));
+            MultiByteToWideChar(CP_UTF8, 0, pending.data(), static_cast<int>(pending.size()), m_wide.data(), length);
+            return writeConsole(m_wide.data(), m_wide.size());
+        }
+
+        bool open = writeStream(pending.data(), pending.size());
+
+        pending.clear();
+        m_pending.swap(pending); // keep the capacity
+
+        return open;
+    }
+
+    /// @brief WriteFile in pieces of at most 1 GiB (it takes a DWORD length).
+    bool OutputSink::writeStream(const char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            DWORD chunk = size > (1u << 30) ? (1u << 30) : static_cast<DWORD>(size);
+            DWORD written = 0;
+
+            if (!WriteFile(m_target, data, chunk, &written, nullptr))
+                return m_open = false; // reader exited
+
+            data += written;
+            size -= written;
+        }
+
+        return true;
+    }
+
+    /// @brief Converts complete characters and holds back an incomplete last one.
+    bool OutputSink::writeConsole(const char *data, size_t size)
+    {
+        if (!m_pending.empty())
+        {
+            // Complete the held back character with the continuation bytes that follow
+            size_t take = 0;
+            while (take < size && m_pending.size() + take < 4 && (static_cast<unsigned char>(data[take]) & 0xC0) == 0x80)
+                ++take;
+
+            m_pending.append(data, take);
+            data += take;
+            size -= take;
+
+            if (unicode::utf8_complete_length(m_pending.data(), m_pending.size()) < m_pending.size() && size == 0)
+                return true; // still incomplete; wait for more
+
+            if (!flush())
+                return false;
+        }
+
+        const size_t complete = unicode::utf8_complete_length(data, size);
+        m_pending.assign(data + complete, size - complete);
+
+        if (complete == 0)
+            return true;
+
+        int length = MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(complete), nullptr, 0);
+        m_wide.resize(static_cast<size_t>(length));
+        MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(complete), m_wide.data(), length);
+
+        return writeConsole(m_wide.data(), m_wide.size());
+    }
+
+    bool OutputSink::writeConsole(const wchar_t *text, size_t length)
+    {
+        DWORD written = 0;
+        if (length > 0 && !WriteConsoleW(m_target, text, static_cast<DWORD>(length), &written, nullptr))
+            return m_open = false;
+
+        return true;
+    }
+}
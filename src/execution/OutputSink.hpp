@@ -0,0 +1,100 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\execution\OutputSink.hpp
+// PURPOSE: Header file for 'src\execution\OutputSink.cpp'. Takes a built-in's output as UTF-8 bytes.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <string>
+
+#include <windows.h>
+
+namespace Execution
+{
+    class Channel;
+
+    /**
+     * @class OutputSink
+     * @brief Where a built-in's standard output goes, fed with UTF-8 bytes.
+     *
+     * The kind of target is found once when it is bound: a channel to the
+     * next built-in, the console, or a stream (file, pipe, NUL). Only the
+     * console needs UTF-16: complete characters are converted there and an
+     * incomplete one at the end of a write is held back for the next.
+     * Streams get the bytes untouched, gathered into 64 KB writes; channels
+     * buffer on their own.
+     *
+     * Stream output is only guaranteed to be written after flush(), which
+     * the executor calls when a built-in returns.
+     */
+    class OutputSink
+    {
+    public:
+        static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+        OutputSink() = default;
+        ~OutputSink();
+
+        OutputSink(OutputSink &&) = default;
+        OutputSink &operator=(OutputSink &&) = default;
+
+        OutputSink(const OutputSink &) = delete;
+        OutputSink &operator=(const OutputSink &) = delete;
+
+        /**
+         * @brief Points the sink at a channel or a handle; output buffered for the old target is flushed first.
+         *
+         * @param channel Next built-in stage, or nullptr.
+         * @param handle  Used without a channel; nullptr or INVALID_HANDLE_VALUE means the process's stdout.
+         */
+        void bind(Channel *channel, HANDLE handle);
+
+        /// @return false once the reader has gone away.
+        bool write(const char *data, size_t size);
+
+        /// @brief UTF-16 text: written as is to the console, as UTF-8 elsewhere.
+        bool write(const std::wstring &text);
+
+        /// @brief Writes out what is buffered or held back.
+        bool flush();
+
+    private:
+        enum class Kind : unsigned char
+        {
+            CHANNEL,
+            CONSOLE,
+            STREAM
+        };
+
+        bool writeStream(const char *data, size_t size);
+        bool writeConsole(const char *data, size_t size);
+        bool writeConsole(const wchar_t *text, size_t length);
+
+        Channel *m_channel = nullptr;
+        HANDLE m_handle = nullptr; ///< As bound, before falling back to stdout
+        HANDLE m_target = INVALID_HANDLE_VALUE;
+        Kind m_kind = Kind::STREAM;
+        bool m_bound = false;
+        bool m_open = true;
+
+        std::string m_pending; ///< Stream: buffered bytes. Console: an incomplete character.
+        std::wstring m_wide;   ///< Console conversion buffer, reused
+    };
+}
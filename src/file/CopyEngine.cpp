@@ -0,0 +1,794 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\CopyEngine.cpp
+// PURPOSE: Parallel recursive copy used by 'cp'.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <thread>
+
+#include <windows.h>
+#include <winioctl.h>
+
+#include "CopyEngine.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Largest range cloned by one FSCTL_DUPLICATE_EXTENTS_TO_FILE call.
+static constexpr LONGLONG CLONE_CHUNK = 1ll << 30;
+
+/// @brief Outcome of a block clone attempt.
+enum class CloneResult
+{
+    CLONED,
+    UNSUPPORTED, ///< The volume cannot clone (not ReFS, different volumes, ...); copy instead
+    FAILED,
+};
+
+/**
+ * @brief Clones a file's blocks into a new file on the same ReFS volume.
+ *
+ * The copy shares the source's clusters until either file is written to,
+ * so it takes the same time for any file size. Times and attributes are
+ * carried over like CopyFileExW does.
+ *
+ * @param src Source file.
+ * @param dst Destination file; replaced.
+ * @return CLONED, or UNSUPPORTED if the caller should fall back to copying.
+ */
+static CloneResult cloneFile(const std::wstring &src, const std::wstring &dst)
+{
+    HANDLE in = CreateFileW(src.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (in == INVALID_HANDLE_VALUE)
+        return CloneResult::FAILED;
+
+    // Only ReFS answers this; it also gives the cluster size clone ranges are aligned to
+    FSCTL_GET_INTEGRITY_INFORMATION_BUFFER integrity{};
+    DWORD returned = 0;
+    if (!DeviceIoControl(in, FSCTL_GET_INTEGRITY_INFORMATION, nullptr, 0, &integrity, sizeof(integrity), &returned, nullptr))
+    {
+        CloseHandle(in);
+        return CloneResult::UNSUPPORTED;
+    }
+
+    FILE_BASIC_INFO basic{};
+    LARGE_INTEGER size{};
+    if (!GetFileInformationByHandleEx(in, FileBasicInfo, &basic, sizeof(basic)) || !GetFileSizeEx(in, &size))
+    {
+        CloseHandle(in);
+        return CloneResult::FAILED;
+    }
+
+    HANDLE out = CreateFileW(dst.c_str(), GENERIC_READ | GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS, 0, nullptr);
+    if (out == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(in);
+        return CloneResult::FAILED;
+    }
+
+    // Both files must agree on sparseness and integrity streams before cloning
+    if (basic.FileAttributes & FILE_ATTRIBUTE_SPARSE_FILE)
+        DeviceIoControl(out, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &returned, nullptr);
+
+    FSCTL_SET_INTEGRITY_INFORMATION_BUFFER setIntegrity{integrity.ChecksumAlgorithm, 0, integrity.Flags};
+    DeviceIoControl(out, FSCTL_SET_INTEGRITY_INFORMATION, &setIntegrity, sizeof(setIntegrity), nullptr, 0, &returned, nullptr);
+
+    FILE_END_OF_FILE_INFO eof{};
+    eof.EndOfFile = size;
+    bool ok = SetFileInformationByHandle(out, FileEndOfFileInfo, &eof, sizeof(eof)) != 0;
+
+    const LONGLONG cluster = integrity.ClusterSizeInBytes ? integrity.ClusterSizeInBytes : 4096;
+    const LONGLONG rounded = (size.QuadPart + cluster - 1) / cluster * cluster; // the tail cluster is cloned whole
+
+    for (LONGLONG offset = 0; ok && offset < rounded; offset += CLONE_CHUNK)
+    {
+        DUPLICATE_EXTENTS_DATA extents{};
+        extents.FileHandle = in;
+        extents.SourceFileOffset.QuadPart = offset;
+        extents.TargetFileOffset.QuadPart = offset;
+        extents.ByteCount.QuadPart = std::min(CLONE_CHUNK, rounded - offset);
+
+        ok = DeviceIoControl(out, FSCTL_DUPLICATE_EXTENTS_TO_FILE, &extents, sizeof(extents), nullptr, 0, &returned, nullptr) != 0;
+    }
+
+    if (ok)
+        ok = SetFileInformationByHandle(out, FileBasicInfo, &basic, sizeof(basic)) != 0;
+
+    if (!ok)
+    {
+        FILE_DISPOSITION_INFO dispose{TRUE}; // don't leave a half-made file behind
+        SetFileInformationByHandle(out, FileDispositionInfo, &dispose, sizeof(dispose));
+    }
+
+    CloseHandle(out);
+    CloseHandle(in);
+
+    return ok ? CloneResult::CLONED : CloneResult::UNSUPPORTED;
+}
+
+/**
+ * @brief Copies a file with CopyFileExW, which keeps attributes and the write time.
+ */
+static bool streamFile(const std::wstring &src, const std::wstring &dst)
+{
+    return CopyFileExW(src.c_str(), dst.c_str(), nullptr, nullptr, nullptr, 0) != 0; // overwrite allowed
+}
+
+/**
+ * @brief Gives a copied directory the source's timestamps and attributes.
+ *
+ * Done after everything inside it was copied, since creating entries
+ * updates a directory's write time.
+ */
+static void copyDirectoryInfo(const std::wstring &src, const std::wstring &dst)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(src.c_str(), GetFileExInfoStandard, &data))
+        return;
+
+    HANDLE h = CreateFileW(dst.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return;
+
+    FILE_BASIC_INFO basic{};
+    basic.CreationTime.LowPart = data.ftCreationTime.dwLowDateTime;
+    basic.CreationTime.HighPart = data.ftCreationTime.dwHighDateTime;
+    basic.LastAccessTime.LowPart = data.ftLastAccessTime.dwLowDateTime;
+    basic.LastAccessTime.HighPart = data.ftLastAccessTime.dwHighDateTime;
+    basic.LastWriteTime.LowPart = data.ftLastWriteTime.dwLowDateTime;
+    basic.LastWriteTime.HighPart = data.ftLastWriteTime.dwHighDateTime;
+    basic.FileAttributes = data.dwFileAttributes;
+
+    SetFileInformationByHandle(h, FileBasicInfo, &basic, sizeof(basic));
+    CloseHandle(h);
+}
+
+/**
+ * @brief Recreates a junction or directory symbolic link with the same reparse data.
+ *
+ * Relative symbolic links keep pointing relative to their new place.
+ * Creating a symbolic link needs the privilege for it (or developer mode).
+ */
+static bool copyReparsePoint(const std::wstring &src, const std::wstring &dst)
+{
+    HANDLE in = CreateFileW(src.c_str(), FILE_READ_ATTRIBUTES | FILE_READ_EA, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT, nullptr);
+    if (in == INVALID_HANDLE_VALUE)
+        return false;
+
+    std::vector<BYTE> data(MAXIMUM_REPARSE_DATA_BUFFER_SIZE);
+    DWORD size = 0;
+    const BOOL read = DeviceIoControl(in, FSCTL_GET_REPARSE_POINT, nullptr, 0, data.data(), static_cast<DWORD>(data.size()), &size, nullptr);
+    CloseHandle(in);
+
+    if (!read)
+        return false;
+
+    const bool created = CreateDirectoryW(dst.c_str(), nullptr) != 0;
+    if (!created && GetLastError() != ERROR_ALREADY_EXISTS) // left by an interrupted run: set again
+        return false;
+
+    HANDLE out = CreateFileW(dst.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+                             FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT, nullptr);
+    bool ok = out != INVALID_HANDLE_VALUE;
+    if (ok)
+    {
+        DWORD returned = 0;
+        ok = DeviceIoControl(out, FSCTL_SET_REPARSE_POINT, data.data(), size, nullptr, 0, &returned, nullptr) != 0;
+        CloseHandle(out);
+    }
+
+    if (!ok && created)
+    {
+        const DWORD error = GetLastError();
+        RemoveDirectoryW(dst.c_str());
+        SetLastError(error);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Flushes every file on the volume holding `path` in one call.
+ *
+ * One barrier for a whole tree is much cheaper than one per file, but
+ * opening a volume needs administrator rights.
+ */
+static bool flushVolume(const std::wstring &path)
+{
+    wchar_t root[MAX_PATH];
+    wchar_t volume[64];
+    if (!GetVolumePathNameW(path.c_str(), root, MAX_PATH) ||
+        !GetVolumeNameForVolumeMountPointW(root, volume, 64))
+        return false;
+
+    std::wstring device = volume;
+    if (!device.empty() && device.back() == L'\\')
+        device.pop_back(); // '\\?\Volume{...}' opens the volume, with the slash its root directory
+
+    HANDLE h = CreateFileW(device.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+
+    bool ok = FlushFileBuffers(h) != 0;
+    CloseHandle(h);
+    return ok;
+}
+
+/**
+ * @brief Lists the ranges of a file that hold data.
+ *
+ * A sparse file is asked for its allocated ranges; anything else is one
+ * range covering the whole file.
+ *
+ * @param file Source file.
+ * @param size Its size.
+ * @param sparse Whether it is a sparse file.
+ * @param ranges Receives (offset, length) pairs in file order.
+ * @return false if the ranges could not be read.
+ */
+static bool dataRanges(HANDLE file, uint64_t size, bool sparse, std::vector<std::pair<uint64_t, uint64_t>> &ranges)
+{
+    ranges.clear();
+
+    if (!sparse)
+    {
+        if (size > 0)
+            ranges.emplace_back(0, size);
+        return true;
+    }
+
+    FILE_ALLOCATED_RANGE_BUFFER query{};
+    query.FileOffset.QuadPart = 0;
+    query.Length.QuadPart = static_cast<LONGLONG>(size);
+
+    std::vector<FILE_ALLOCATED_RANGE_BUFFER> found(256);
+
+    while (query.Length.QuadPart > 0)
+    {
+        DWORD returned = 0;
+        const BOOL ok = DeviceIoControl(file, FSCTL_QUERY_ALLOCATED_RANGES, &query, sizeof(query), found.data(),
+                                        static_cast<DWORD>(found.size() * sizeof(FILE_ALLOCATED_RANGE_BUFFER)), &returned, nullptr);
+
+        if (!ok && GetLastError() != ERROR_MORE_DATA)
+            return false;
+
+        const size_t count = returned / sizeof(FILE_ALLOCATED_RANGE_BUFFER);
+        for (size_t i = 0; i < count; ++i)
+            ranges.emplace_back(found[i].FileOffset.QuadPart, found[i].Length.QuadPart);
+
+        if (ok || count == 0)
+            break;
+
+        // More ranges than fit: continue after the last one returned
+        const LONGLONG next = found[count - 1].FileOffset.QuadPart + found[count - 1].Length.QuadPart;
+        query.Length.QuadPart = static_cast<LONGLONG>(size) - next;
+        query.FileOffset.QuadPart = next;
+    }
+
+    return true;
+}
+
+static uint64_t fileTime(const FILETIME &time)
+{
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    CopyEngine::CopyEngine(unsigned workers, bool durable)
+        : m_queue(workers, 2), // copying small files is mostly waiting on the file system
+          m_durable(durable),
+          m_command(durable ? L"mv: " : L"cp: ")
+    {
+    }
+
+    BoolResult CopyEngine::copyFile(const std::wstring &src, const std::wstring &dst, const ProgressCallback &report)
+    {
+        CloneResult cloned = cloneFile(src, dst);
+
+        if (cloned == CloneResult::CLONED)
+            return {true, {}};
+
+        if (cloned == CloneResult::FAILED)
+            return {false, makeLastError(L"cp: " + src)};
+
+        WIN32_FILE_ATTRIBUTE_DATA data{};
+        if (GetFileAttributesExW(src.c_str(), GetFileExInfoStandard, &data))
+        {
+            const uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+            if (size >= CHUNKED_MIN)
+                return copyChunked(src, dst, size, report);
+        }
+
+        if (!streamFile(src, dst))
+            return {false, makeLastError(L"cp: " + src)};
+
+        return {true, {}};
+    }
+
+    /**
+     * @brief Copies one large file with several threads, each on its own handles.
+     *
+     * The data ranges are cut into CHUNK_SIZE pieces that the workers copy
+     * with positioned reads and writes. Holes of a sparse source are never
+     * read or written. Attributes and times are carried over at the end;
+     * a failed copy deletes the destination.
+     */
+    BoolResult CopyEngine::copyChunked(const std::wstring &src, const std::wstring &dst, uint64_t size, const ProgressCallback &report)
+    {
+        constexpr DWORD BLOCK = 1024 * 1024;
+
+        const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+
+        HANDLE in = CreateFileW(src.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (in == INVALID_HANDLE_VALUE)
+            return {false, makeLastError(L"cp: " + src)};
+
+        FILE_BASIC_INFO basic{};
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+
+        if (!GetFileInformationByHandleEx(in, FileBasicInfo, &basic, sizeof(basic)) ||
+            !dataRanges(in, size, (basic.FileAttributes & FILE_ATTRIBUTE_SPARSE_FILE) != 0, ranges))
+        {
+            BoolResult res{false, makeLastError(L"cp: " + src)};
+            CloseHandle(in);
+            return res;
+        }
+
+        CloseHandle(in);
+
+        HANDLE out = CreateFileW(dst.c_str(), GENERIC_WRITE | DELETE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, 0, nullptr);
+        if (out == INVALID_HANDLE_VALUE)
+            return {false, makeLastError(L"cp: " + dst)};
+
+        const bool sparse = (basic.FileAttributes & FILE_ATTRIBUTE_SPARSE_FILE) != 0;
+        DWORD returned = 0;
+
+        if (sparse)
+        {
+            DeviceIoControl(out, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &returned, nullptr);
+        }
+        else
+        {
+            // Reserve the clusters at once: fewer, larger extents and an early 'disk full'
+            FILE_ALLOCATION_INFO allocation{};
+            allocation.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+            SetFileInformationByHandle(out, FileAllocationInfo, &allocation, sizeof(allocation));
+        }
+
+        FILE_END_OF_FILE_INFO eof{};
+        eof.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFileInformationByHandle(out, FileEndOfFileInfo, &eof, sizeof(eof)))
+        {
+            BoolResult res{false, makeLastError(L"cp: " + dst)};
+            FILE_DISPOSITION_INFO dispose{TRUE};
+            SetFileInformationByHandle(out, FileDispositionInfo, &dispose, sizeof(dispose));
+            CloseHandle(out);
+            return res;
+        }
+
+        struct Chunk
+        {
+            uint64_t offset = 0;
+            uint64_t length = 0;
+        };
+
+        WorkQueue<Chunk> queue(0, 1); // one stream per core is enough to keep a disk's queue full
+
+        // Last chunk first: a worker takes from the back, so each walks its share front to back
+        std::vector<Chunk> chunks;
+        for (const auto &[offset, length] : ranges)
+        {
+            for (uint64_t at = 0; at < length; at += CHUNK_SIZE)
+                chunks.push_back({offset + at, std::min<uint64_t>(CHUNK_SIZE, length - at)});
+        }
+
+        const size_t perWorker = (chunks.size() + queue.workers() - 1) / std::max<size_t>(1, queue.workers());
+        for (size_t i = chunks.size(); i-- > 0;)
+            queue.push(static_cast<unsigned>(i / std::max<size_t>(1, perWorker)), chunks[i]);
+
+        std::vector<HANDLE> reads(queue.workers(), INVALID_HANDLE_VALUE);
+        std::vector<HANDLE> writes(queue.workers(), INVALID_HANDLE_VALUE);
+
+        std::atomic<uint64_t> copied{0};
+        std::atomic<bool> failed{false};
+        std::mutex lock;
+        Error firstError;
+
+        auto fail = [&](const Error &error)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!failed.exchange(true))
+                firstError = error;
+        };
+
+        auto run = [&](unsigned worker, const Chunk &chunk)
+        {
+            if (failed.load(std::memory_order_relaxed))
+                return;
+
+            // Each worker has its own handles: I/O on one synchronous handle is serialized
+            if (reads[worker] == INVALID_HANDLE_VALUE)
+            {
+                reads[worker] = CreateFileW(src.c_str(), GENERIC_READ, share, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                writes[worker] = CreateFileW(dst.c_str(), GENERIC_WRITE, share, nullptr, OPEN_EXISTING, 0, nullptr);
+
+                if (reads[worker] == INVALID_HANDLE_VALUE || writes[worker] == INVALID_HANDLE_VALUE)
+                {
+                    fail(makeLastError(L"cp: " + src));
+                    return;
+                }
+            }
+
+            std::vector<char> buffer(BLOCK);
+
+            for (uint64_t done = 0; done < chunk.length && !failed.load(std::memory_order_relaxed);)
+            {
+                const uint64_t at = chunk.offset + done;
+                const DWORD want = static_cast<DWORD>(std::min<uint64_t>(BLOCK, chunk.length - done));
+
+                OVERLAPPED ov{};
+                ov.Offset = static_cast<DWORD>(at);
+                ov.OffsetHigh = static_cast<DWORD>(at >> 32);
+
+                DWORD read = 0;
+                if (!ReadFile(reads[worker], buffer.data(), want, &read, &ov))
+                {
+                    fail(makeLastError(L"cp: " + src));
+                    return;
+                }
+
+                if (read == 0)
+                {
+                    fail({ERROR_HANDLE_EOF, L"cp: '" + src + L"' shrank while it was copied"});
+                    return;
+                }
+
+                DWORD written = 0;
+                if (!WriteFile(writes[worker], buffer.data(), read, &written, &ov) || written != read)
+                {
+                    fail(makeLastError(L"cp: " + dst));
+                    return;
+                }
+
+                done += read;
+                copied.fetch_add(read, std::memory_order_relaxed);
+            }
+        };
+
+        const ULONGLONG start = GetTickCount64();
+        auto snapshot = [&](bool final)
+        {
+            Progress progress;
+            progress.files = final && !failed.load() ? 1 : 0;
+            progress.bytes = copied.load(std::memory_order_relaxed);
+            progress.errors = failed.load() ? 1 : 0;
+            progress.seconds = (GetTickCount64() - start) / 1000.0;
+            return progress;
+        };
+
+        if (!chunks.empty()) // a sparse file may be all hole
+        {
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < queue.workers(); ++i)
+                threads.emplace_back([&queue, i, &run]() { queue.work(i, run); });
+
+            while (!queue.wait(250))
+            {
+                if (report)
+                    report(snapshot(false), false);
+            }
+
+            for (auto &thread : threads)
+                thread.join();
+        }
+
+        for (unsigned i = 0; i < queue.workers(); ++i)
+        {
+            if (reads[i] != INVALID_HANDLE_VALUE)
+                CloseHandle(reads[i]);
+            if (writes[i] != INVALID_HANDLE_VALUE)
+                CloseHandle(writes[i]);
+        }
+
+        if (!failed.load())
+        {
+            // Last, since the writes above update the write time
+            basic.FileAttributes &= ~FILE_ATTRIBUTE_SPARSE_FILE; // set by FSCTL_SET_SPARSE, not here
+            if (!SetFileInformationByHandle(out, FileBasicInfo, &basic, sizeof(basic)))
+                fail(makeLastError(L"cp: " + dst));
+        }
+
+        if (failed.load())
+        {
+            FILE_DISPOSITION_INFO dispose{TRUE}; // don't leave a half-made file behind
+            SetFileInformationByHandle(out, FileDispositionInfo, &dispose, sizeof(dispose));
+        }
+
+        CloseHandle(out);
+
+        if (report)
+            report(snapshot(true), true);
+
+        if (failed.load())
+            return {false, firstError};
+
+        return {true, {}};
+    }
+
+    BoolResult CopyEngine::verifyFile(const std::wstring &path, uint64_t size, bool flush)
+    {
+        const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+        HANDLE h = CreateFileW(path.c_str(), flush ? GENERIC_WRITE : FILE_READ_ATTRIBUTES, share, nullptr, OPEN_EXISTING, 0, nullptr);
+
+        DWORD attributes = INVALID_FILE_ATTRIBUTES;
+        if (h == INVALID_HANDLE_VALUE && flush && GetLastError() == ERROR_ACCESS_DENIED)
+        {
+            // Copies keep the read-only attribute, which also refuses write handles
+            attributes = GetFileAttributesW(path.c_str());
+            if (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_READONLY) &&
+                SetFileAttributesW(path.c_str(), attributes & ~FILE_ATTRIBUTE_READONLY))
+                h = CreateFileW(path.c_str(), GENERIC_WRITE, share, nullptr, OPEN_EXISTING, 0, nullptr);
+            else
+                attributes = INVALID_FILE_ATTRIBUTES;
+        }
+
+        if (h == INVALID_HANDLE_VALUE)
+        {
+            BoolResult res{false, makeLastError(L"mv: " + path)};
+            if (attributes != INVALID_FILE_ATTRIBUTES)
+                SetFileAttributesW(path.c_str(), attributes);
+            return res;
+        }
+
+        BoolResult res{true, {}};
+
+        LARGE_INTEGER actual{};
+        if (!GetFileSizeEx(h, &actual))
+            res = {false, makeLastError(L"mv: " + path)};
+        else if (static_cast<uint64_t>(actual.QuadPart) != size)
+            res = {false, {ERROR_FILE_INVALID, L"mv: '" + path + L"' does not have the size of its source"}};
+        else if (flush && !FlushFileBuffers(h))
+            res = {false, makeLastError(L"mv: " + path)};
+
+        CloseHandle(h);
+
+        if (attributes != INVALID_FILE_ATTRIBUTES)
+            SetFileAttributesW(path.c_str(), attributes);
+
+        return res;
+    }
+
+    BoolResult CopyEngine::copyTree(const std::wstring &src, const std::wstring &dst, const ProgressCallback &report)
+    {
+        m_start = GetTickCount64();
+
+        m_queue.push(0, {src, dst, 0, true});
+
+        auto run = [this](unsigned worker, const Task &task)
+        {
+            if (task.directory)
+                listDirectory(worker, task);
+            else if (task.link)
+                copyLink(task);
+            else
+                copyEntry(task);
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < m_queue.workers(); ++i)
+            threads.emplace_back([this, i, &run]() { m_queue.work(i, run); });
+
+        while (!m_queue.wait(250))
+        {
+            if (report)
+                report(snapshot(), false);
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+
+        for (const auto &[dirSrc, dirDst] : m_copiedDirectories)
+            copyDirectoryInfo(dirSrc, dirDst);
+
+        if (m_durable && m_errors.load() == 0)
+            flushWritten();
+
+        if (report)
+            report(snapshot(), true);
+
+        if (m_errors.load() > 0)
+        {
+            if (!m_firstError.hasError())
+                return {false, {0, m_command + std::wstring(L"some files could not be copied")}};
+
+            return {false, m_firstError};
+        }
+
+        return {true, {}};
+    }
+
+    void CopyEngine::listDirectory(unsigned worker, const Task &task)
+    {
+        if (!CreateDirectoryW(task.dst.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS)
+        {
+            fail(makeLastError(m_command + task.dst));
+            return;
+        }
+
+        WIN32_FIND_DATAW ffd;
+        std::wstring search = task.src + L"\\*";
+
+        // Basic info skips the 8.3 names; large fetch returns more entries per call
+        HANDLE hFind = FindFirstFileExW(search.c_str(), FindExInfoBasic, &ffd, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+        if (hFind == INVALID_HANDLE_VALUE)
+        {
+            fail(makeLastError(m_command + task.src));
+            return;
+        }
+
+        do
+        {
+            if (wcscmp(ffd.cFileName, L".") == 0 ||
+                wcscmp(ffd.cFileName, L"..") == 0)
+                continue;
+
+            Task child;
+            child.src = task.src + L"\\" + ffd.cFileName;
+            child.dst = task.dst + L"\\" + ffd.cFileName;
+            child.size = (static_cast<uint64_t>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow;
+            child.lastWrite = fileTime(ffd.ftLastWriteTime);
+            child.directory = (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+            // Links only; other reparse points (e.g. cloud placeholders) are real directories
+            if (child.directory && (ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) &&
+                IsReparseTagNameSurrogate(ffd.dwReserved0))
+            {
+                child.directory = false;
+                child.link = true;
+            }
+
+            m_queue.push(worker, std::move(child));
+
+        } while (FindNextFileW(hFind, &ffd));
+
+        FindClose(hFind);
+
+        m_directories.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_copiedDirectories.emplace_back(task.src, task.dst);
+    }
+
+    void CopyEngine::copyEntry(const Task &task)
+    {
+        if (m_durable)
+        {
+            // Finished by an interrupted run: copies get the source's write time once complete
+            WIN32_FILE_ATTRIBUTE_DATA data{};
+            if (GetFileAttributesExW(task.dst.c_str(), GetFileExInfoStandard, &data) &&
+                ((static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow) == task.size &&
+                fileTime(data.ftLastWriteTime) == task.lastWrite)
+            {
+                written(task);
+                return;
+            }
+        }
+
+        if (!m_cloneUnsupported.load(std::memory_order_relaxed))
+        {
+            switch (cloneFile(task.src, task.dst))
+            {
+            case CloneResult::CLONED:
+                written(task);
+                return;
+
+            case CloneResult::UNSUPPORTED:
+                m_cloneUnsupported.store(true, std::memory_order_relaxed); // the whole tree is on one volume
+                break;
+
+            case CloneResult::FAILED:
+                fail(makeLastError(m_command + task.src));
+                return;
+            }
+        }
+
+        if (!streamFile(task.src, task.dst))
+        {
+            fail(makeLastError(m_command + task.src));
+            return;
+        }
+
+        written(task);
+    }
+
+    void CopyEngine::copyLink(const Task &task)
+    {
+        if (!copyReparsePoint(task.src, task.dst))
+        {
+            fail(makeLastError(m_command + task.src));
+            return;
+        }
+
+        m_directories.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void CopyEngine::written(const Task &task)
+    {
+        m_files.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(task.size, std::memory_order_relaxed);
+
+        if (!m_durable)
+            return;
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_written.emplace_back(task.dst, task.size);
+    }
+
+    /**
+     * @brief Flushes and verifies every file of a durable copy.
+     *
+     * Runs after all data was written, so the flushes do not hold up the
+     * copy and the disk can order the writes freely in between.
+     */
+    void CopyEngine::flushWritten()
+    {
+        const bool flushed = !m_written.empty() && flushVolume(m_written.front().first);
+
+        std::atomic<size_t> next{0};
+        auto run = [&]()
+        {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < m_written.size();)
+            {
+                auto res = verifyFile(m_written[i].first, m_written[i].second, !flushed);
+                if (!res.ok())
+                    fail(res.error);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < m_queue.workers(); ++i)
+            threads.emplace_back(run);
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    void CopyEngine::fail(const Error &error)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        if (m_errors.fetch_add(1, std::memory_order_relaxed) == 0)
+            m_firstError = error;
+    }
+
+    CopyEngine::Progress CopyEngine::snapshot() const
+    {
+        Progress progress;
+        progress.files = m_files.load(std::memory_order_relaxed);
+        progress.directories = m_directories.load(std::memory_order_relaxed);
+        progress.bytes = m_bytes.load(std::memory_order_relaxed);
+        progress.errors = m_errors.load(std::memory_order_relaxed);
+        progress.seconds = (GetTickCount64() - m_start) / 1000.0;
+        return progress;
+    }
+}
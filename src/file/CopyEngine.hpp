@@ -0,0 +1,157 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\CopyEngine.hpp
+// PURPOSE: Header file for 'src\file\CopyEngine.cpp'. Parallel recursive copy used by 'cp'.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include "../headers/Result.hpp"
+#include "WorkQueue.hpp"
+
+namespace FileIO
+{
+    /**
+     * @brief Copies directory trees with a pool of work-stealing threads.
+     *
+     * Tasks (a directory to list or a file to copy) go through a WorkQueue.
+     * Each worker copies one file at a time, so the number of files in
+     * flight is bounded by the worker count.
+     *
+     * Files are block-cloned when the volume supports it (ReFS) and copied
+     * with CopyFileExW otherwise. Attributes and timestamps are preserved
+     * for files and directories.
+     *
+     * Junctions and directory symbolic links are recreated as links to the
+     * same target, never entered: following them could copy a tree into
+     * itself, and a 'mv' would turn a link into a copy of what it points to.
+     *
+     * A durable copy (used by a cross-volume 'mv') flushes every copied file
+     * once the whole tree is written, then checks its size against the
+     * source; files an interrupted run already finished are not copied again.
+     */
+    class CopyEngine
+    {
+    public:
+        /**
+         * @brief Counters reported while a copy runs.
+         */
+        struct Progress
+        {
+            uint64_t files = 0;
+            uint64_t directories = 0;
+            uint64_t bytes = 0;
+            uint64_t errors = 0;
+            double seconds = 0.0; ///< Time since the copy started
+        };
+
+        /// Called about every 250 ms on the calling thread, and once more with `final` set
+        using ProgressCallback = std::function<void(const Progress &progress, bool final)>;
+
+        /**
+         * @param workers Number of copy threads; 0 picks one from the CPU count.
+         * @param durable Flush and verify the copy before copyTree returns.
+         */
+        explicit CopyEngine(unsigned workers = 0, bool durable = false);
+
+        /**
+         * @brief Copies a directory tree. Blocks until done.
+         *
+         * Failed entries are skipped and counted; the first failure is returned.
+         *
+         * @param src    Source directory.
+         * @param dst    Destination directory; created if missing.
+         * @param report Optional progress callback.
+         */
+        BoolResult copyTree(const std::wstring &src, const std::wstring &dst, const ProgressCallback &report = {});
+
+        static constexpr uint64_t CHUNKED_MIN = 64ull * 1024 * 1024; ///< Smaller files are copied by one CopyFileExW
+        static constexpr uint64_t CHUNK_SIZE = 32ull * 1024 * 1024;  ///< Unit of work of a chunked copy
+
+        /**
+         * @brief Copies one file, block-cloning it if the volume allows.
+         *
+         * Files of CHUNKED_MIN bytes and more are copied in chunks by
+         * several threads. The destination is allocated up front, and only
+         * the allocated ranges of a sparse source are copied, so it stays
+         * sparse.
+         *
+         * @param src    Source file.
+         * @param dst    Destination file; overwritten if it exists.
+         * @param report Optional progress callback for chunked copies.
+         */
+        static BoolResult copyFile(const std::wstring &src, const std::wstring &dst, const ProgressCallback &report = {});
+
+        /**
+         * @brief Checks a copied file's size and optionally flushes it to disk.
+         *
+         * @param path  Copied file.
+         * @param size  Size of the source.
+         * @param flush Also wait until the file's data is on the disk.
+         */
+        static BoolResult verifyFile(const std::wstring &path, uint64_t size, bool flush);
+
+    private:
+        static BoolResult copyChunked(const std::wstring &src, const std::wstring &dst, uint64_t size, const ProgressCallback &report);
+
+        struct Task
+        {
+            std::wstring src;
+            std::wstring dst;
+            uint64_t size = 0;
+            uint64_t lastWrite = 0;
+            bool directory = false;
+            bool link = false; ///< Junction or directory symbolic link
+        };
+
+        void listDirectory(unsigned worker, const Task &task);
+        void copyEntry(const Task &task);
+        void copyLink(const Task &task);
+        void written(const Task &task);
+        void fail(const Error &error);
+        void flushWritten();
+        Progress snapshot() const;
+
+        WorkQueue<Task> m_queue;
+
+        const bool m_durable;
+        const wchar_t *m_command; ///< Prefix of error messages
+
+        std::atomic<bool> m_cloneUnsupported{false}; ///< Set after the first clone the volume refuses
+
+        std::atomic<uint64_t> m_files{0};
+        std::atomic<uint64_t> m_directories{0};
+        std::atomic<uint64_t> m_bytes{0};
+        std::atomic<uint64_t> m_errors{0};
+        ULONGLONG m_start = 0;
+
+        std::mutex m_lock; ///< Guards the members below
+        Error m_firstError;
+        std::vector<std::pair<std::wstring, std::wstring>> m_copiedDirectories; ///< Timestamps are set once the tree is done
+        std::vector<std::pair<std::wstring, uint64_t>> m_written;                ///< Durable copies: files still to flush and verify
+    };
+}
@@ -0,0 +1,182 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\CountEngine.cpp
+// PURPOSE: Parallel line, word and byte counts used by 'stats'.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <windows.h>
+
+#include "../headers/ByteScan.hpp"
+#include "CountEngine.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief What one chunk contributes; merged in file order afterwards.
+struct ChunkCounts
+{
+    bytescan::TextCounts counts;
+    bool startsInWord = false; ///< First byte is not whitespace
+    bool endsInWord = false;   ///< Last byte is not whitespace
+    DWORD error = 0;
+};
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    Result<CountEngine::Counts> CountEngine::count(HANDLE file, const Counts *resume, unsigned workers)
+    {
+        const Counts start = resume ? *resume : Counts{};
+
+        LARGE_INTEGER size{};
+        if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            return countSequential(file, start);
+
+        const uint64_t total = static_cast<uint64_t>(size.QuadPart);
+        if (total <= start.bytes)
+            return {start, {}}; // nothing new (a shrunk file is the caller's business)
+
+        HANDLE hMap = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!hMap)
+            return countSequential(file, start);
+
+        const uint64_t first = start.bytes;
+        const size_t chunkCount = static_cast<size_t>((total - first + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+        if (workers == 0)
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = static_cast<unsigned>(std::min<size_t>(workers, chunkCount));
+
+        std::vector<ChunkCounts> chunks(chunkCount);
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+
+        // Chunks are handed out in file order, so the disk is read front to back
+        auto run = [&]()
+        {
+            for (size_t i; !failed.load(std::memory_order_relaxed) && (i = next.fetch_add(1)) < chunkCount;)
+            {
+                const uint64_t offset = first + i * CHUNK_SIZE;
+                const uint64_t length = std::min(CHUNK_SIZE, total - offset);
+
+                // A resumed count starts anywhere: map from the granularity boundary before it
+                const uint64_t mapOffset = offset - offset % GRANULARITY;
+                const SIZE_T skip = static_cast<SIZE_T>(offset - mapOffset);
+                const SIZE_T viewLength = skip + static_cast<SIZE_T>(length);
+
+                const char *view = static_cast<const char *>(MapViewOfFile(
+                    hMap, FILE_MAP_READ, static_cast<DWORD>(mapOffset >> 32), static_cast<DWORD>(mapOffset), viewLength));
+                if (!view)
+                {
+                    chunks[i].error = GetLastError();
+                    failed = true;
+                    break;
+                }
+
+                // One large read for the whole chunk instead of a fault per page
+                WIN32_MEMORY_RANGE_ENTRY range{const_cast<char *>(view), viewLength};
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+                const char *data = view + skip;
+
+                ChunkCounts &chunk = chunks[i];
+                bool inWord = false;
+                bytescan::countText(data, static_cast<size_t>(length), chunk.counts, inWord);
+                chunk.startsInWord = !bytescan::isSpace(data[0]);
+                chunk.endsInWord = inWord;
+
+                UnmapViewOfFile(view);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < workers; ++i)
+            threads.emplace_back(run);
+
+        run(); // the calling thread is a worker too
+
+        for (auto &thread : threads)
+            thread.join();
+
+        CloseHandle(hMap);
+
+        Result<Counts> result;
+        result.value = start;
+        result.value.bytes = total;
+
+        bool previousEndsInWord = start.endsInWord;
+
+        for (const auto &chunk : chunks)
+        {
+            if (chunk.error)
+            {
+                SetLastError(chunk.error);
+                return {{}, makeLastError(L"stats")};
+            }
+
+            result.value.lines += chunk.counts.lines;
+            result.value.words += chunk.counts.words;
+
+            if (previousEndsInWord && chunk.startsInWord)
+                --result.value.words; // one word across the boundary, counted on both sides
+
+            previousEndsInWord = chunk.endsInWord;
+        }
+
+        result.value.endsInWord = previousEndsInWord;
+        return result;
+    }
+
+    /// @brief Reads the handle front to back in 1 MB blocks on the calling thread.
+    Result<CountEngine::Counts> CountEngine::countSequential(HANDLE file, const Counts &start)
+    {
+        constexpr DWORD BUFFER_SIZE = 1024 * 1024;
+
+        if (start.bytes > 0)
+        {
+            LARGE_INTEGER offset{};
+            offset.QuadPart = static_cast<LONGLONG>(start.bytes);
+            if (!SetFilePointerEx(file, offset, nullptr, FILE_BEGIN))
+                return {{}, makeLastError(L"stats")};
+        }
+
+        std::vector<char> buffer(BUFFER_SIZE);
+        bytescan::TextCounts counts{start.lines, start.words};
+        bool inWord = start.endsInWord;
+
+        Result<Counts> result;
+        result.value.bytes = start.bytes;
+        DWORD bytesRead = 0;
+
+        while (ReadFile(file, buffer.data(), BUFFER_SIZE, &bytesRead, nullptr) && bytesRead > 0)
+        {
+            bytescan::countText(buffer.data(), bytesRead, counts, inWord);
+            result.value.bytes += bytesRead;
+        }
+
+        result.value.lines = counts.lines;
+        result.value.words = counts.words;
+        result.value.endsInWord = inWord;
+        return result;
+    }
+}
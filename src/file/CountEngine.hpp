@@ -0,0 +1,76 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\CountEngine.hpp
+// PURPOSE: Header file for 'src\file\CountEngine.cpp'. Parallel line, word and byte counts used by 'stats'.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstdint>
+
+#include <windows.h>
+
+#include "../headers/Result.hpp"
+
+namespace FileIO
+{
+    /**
+     * @brief Counts the lines, words and bytes of a file on all cores.
+     *
+     * The file is split into fixed-size chunks that worker threads take in
+     * order. Each worker maps its chunk, prefetches the whole view so the
+     * disk sees large reads, and counts it with bytescan::countText as if
+     * the chunk followed whitespace. Merging in file order then subtracts
+     * one word wherever a word runs across a chunk boundary.
+     *
+     * Handles that cannot be mapped (empty files, devices) are read
+     * sequentially instead.
+     *
+     * A count can resume from an earlier one: only the bytes after it are
+     * read, and the word state at its end joins the two.
+     */
+    class CountEngine
+    {
+    public:
+        static constexpr uint64_t CHUNK_SIZE = 16ull * 1024 * 1024; ///< Multiple of the 64 KB allocation granularity
+
+        struct Counts
+        {
+            uint64_t lines = 0;
+            uint64_t words = 0;
+            uint64_t bytes = 0;
+            bool endsInWord = false; ///< The last byte counted is not whitespace
+        };
+
+        /**
+         * @brief Counts a file from the start, or from where an earlier count ended.
+         *
+         * @param file    Handle opened with GENERIC_READ.
+         * @param resume  Counts of the file's first resume->bytes bytes, or
+         *                nullptr to count from the start.
+         * @param workers Number of threads; 0 picks one per core.
+         * @return The counts of the whole file, or the error that stopped the count.
+         */
+        static Result<Counts> count(HANDLE file, const Counts *resume = nullptr, unsigned workers = 0);
+
+    private:
+        static constexpr uint64_t GRANULARITY = 64 * 1024; ///< Views must start on a multiple of this
+
+        static Result<Counts> countSequential(HANDLE file, const Counts &start);
+    };
+}
@@ -0,0 +1,93 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\DeleteEngine.hpp
+// PURPOSE: Header file for 'src\file\DeleteEngine.cpp'. Parallel recursive delete used by 'rm -r'.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <windows.h>
+
+#include "../headers/Result.hpp"
+#include "WorkQueue.hpp"
+
+namespace FileIO
+{
+    /**
+     * @brief Deletes directory trees with a pool of work-stealing threads.
+     *
+     * A task lists one directory in large batches, deletes its files on the
+     * spot and pushes its subdirectories. Each directory counts its pending
+     * subdirectories; the last one to finish removes it, and so on up to the
+     * root. Symbolic links and junctions are removed themselves and never
+     * followed. Read-only entries are made writable first.
+     */
+    class DeleteEngine
+    {
+    public:
+        /**
+         * @param workers Number of threads; 0 picks one from the CPU count.
+         */
+        explicit DeleteEngine(unsigned workers = 0);
+
+        /**
+         * @brief Deletes a file or a directory tree. Blocks until done.
+         *
+         * Entries that cannot be deleted are skipped and counted; the first
+         * failure is returned.
+         *
+         * @param path       File or directory.
+         * @param background Run at background CPU and I/O priority.
+         */
+        BoolResult deleteTree(const std::wstring &path, bool background = false);
+
+        uint64_t deleted() const { return m_deleted.load(); }
+
+    private:
+        struct Node
+        {
+            std::wstring path;
+            DWORD attributes = 0;
+            Node *parent = nullptr;
+            std::atomic<uint32_t> refs{1}; ///< Its own listing plus each pending subdirectory
+        };
+
+        struct Task
+        {
+            Node *node = nullptr;
+        };
+
+        void listDirectory(unsigned worker, Node *node);
+        void release(Node *node);
+        bool removeEntry(const std::wstring &path, DWORD attributes);
+        void fail(const Error &error);
+
+        WorkQueue<Task> m_queue;
+
+        std::atomic<uint64_t> m_deleted{0};
+        std::atomic<uint64_t> m_errors{0};
+
+        std::mutex m_lock; ///< Guards m_firstError
+        Error m_firstError;
+    };
+}
@@ -22,7 +22,7 @@ limitations under the License.
 #include <vector>
 #include <string>
 #include <iostream>
-#include <deque>
+#include <algorithm>
 
 #include <windows.h>
 
@@ -31,52 +31,269 @@ limitations under the License.
 #include "../headers/Console.hpp"
 #include "../headers/Unicode.hpp"
 #include "../headers/Helper.hpp"
+#include "../headers/ByteScan.hpp"
 #include "../execution/Execution.hpp"
 #include "FileCommands.hpp"
+#include "CopyEngine.hpp"
+#include "CountEngine.hpp"
+#include "TreeWalker.hpp"
+#include "MetadataCache.hpp"
+#include "MoveEngine.hpp"
+#include "Purger.hpp"
+#include "StatsCache.hpp"
+#include "TailFollower.hpp"
 
 // HELPER FUNCTIONS
 
-/// @brief Writes a string to the given handle, considering console vs. file output.
-/// @param h The Windows HANDLE (stdout, stderr, or file handle).
-/// @param text The text to write.
-static void writeOut(HANDLE h, const std::wstring &text)
+/// @brief Whether a command can read its input instead of a file operand.
+///
+/// True inside a pipeline (the previous stage) and for a '< file'
+/// redirection, which replaces the console stdin with a file or pipe.
+static bool hasInput(const Execution::Executor::Context &ctx)
 {
-    DWORD mode;
-    if (GetConsoleMode(h, &mode))
+    if (ctx.pipelineEnabled)
+        return true;
+
+    return ctx.redirectionEnabled && ctx.stdinHandle && ctx.stdinHandle != INVALID_HANDLE_VALUE &&
+           GetFileType(ctx.stdinHandle) != FILE_TYPE_CHAR;
+}
+
+/// @brief Prints the last lines of a seekable file by scanning backward from its end.
+///
+/// Reads 1 MB blocks from the end until enough line breaks are found, so the
+/// cost depends on the size of the output rather than of the file. The lines
+/// are then copied out as raw bytes.
+///
+/// @param hFile      Disk file (any position; reads are positioned).
+/// @param lineCount  Number of lines to print.
+/// @param ctx        Execution context.
+/// @param followFrom If given, receives where the output ended, and no line
+///                   break is added after an unfinished last line.
+/// @return BoolResult indicating success or failure.
+static BoolResult tailFromEnd(HANDLE hFile, size_t lineCount, Execution::Executor::Context &ctx, uint64_t *followFrom = nullptr)
+{
+    constexpr uint64_t BLOCK_SIZE = 1024 * 1024;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(hFile, &size))
+        return {false, makeLastError(L"tail")};
+
+    const uint64_t end = static_cast<uint64_t>(size.QuadPart);
+    if (followFrom)
+        *followFrom = end;
+
+    if (end == 0 || lineCount == 0)
+        return {true, {}};
+
+    std::vector<char> block(BLOCK_SIZE);
+
+    auto readAt = [&](uint64_t offset, DWORD length) -> bool
+    {
+        OVERLAPPED ov{};
+        ov.Offset = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD read = 0;
+        return ReadFile(hFile, block.data(), length, &read, &ov) && read == length;
+    };
+
+    // Find where the last `lineCount` lines start; stays 0 if the file has fewer
+    uint64_t start = 0;
+    bool trailingNewline = false;
+    size_t found = 0;
+
+    for (uint64_t pos = end; pos > 0;)
     {
-        WriteConsoleW(h, text.c_str(), static_cast<DWORD>(text.size()), nullptr, nullptr);
-        console::writeln(text);
+        const DWORD length = static_cast<DWORD>(pos < BLOCK_SIZE ? pos : BLOCK_SIZE);
+        const uint64_t offset = pos - length;
+
+        if (!readAt(offset, length))
+            return {false, makeLastError(L"tail")};
+
+        size_t scan = length;
+        if (pos == end && block[length - 1] == '\n')
+        {
+            trailingNewline = true; // ends the last line rather than starting a new one
+            --scan;
+        }
+
+        bool done = false;
+        while (const char *newline = bytescan::findLast(block.data(), scan, '\n'))
+        {
+            scan = static_cast<size_t>(newline - block.data());
+
+            if (++found == lineCount)
+            {
+                start = offset + scan + 1;
+                done = true;
+                break;
+            }
+        }
+
+        if (done)
+            break;
+
+        pos = offset;
     }
-    else
+
+    for (uint64_t offset = start; offset < end;)
     {
-        DWORD written = 0;
-        WriteFile(h, text.c_str(), static_cast<DWORD>(text.size() * sizeof(wchar_t)), &written, nullptr);
+        const DWORD length = static_cast<DWORD>(end - offset < BLOCK_SIZE ? end - offset : BLOCK_SIZE);
+
+        if (!readAt(offset, length))
+            return {false, makeLastError(L"tail")};
+
+        if (!Execution::Executor::writeBytes(ctx, block.data(), length))
+            return {true, {}}; // the next stage stopped reading
+
+        offset += length;
     }
+
+    if (!trailingNewline && !followFrom)
+        Execution::Executor::writeBytes(ctx, "\n", 1);
+
+    return {true, {}};
+}
+
+/// @brief Where the last `lineCount` lines of a buffer start.
+/// @return 0 if the buffer has no more lines than that.
+static size_t lastLinesStart(const std::string &data, size_t lineCount)
+{
+    size_t scan = data.size();
+    if (scan > 0 && data[scan - 1] == '\n')
+        --scan; // ends the last line rather than starting a new one
+
+    for (size_t found = 0; const char *newline = bytescan::findLast(data.data(), scan, '\n');)
+    {
+        scan = static_cast<size_t>(newline - data.data());
+        if (++found == lineCount)
+            return scan + 1;
+    }
+
+    return 0;
+}
+
+/// @brief Prints the last lines of input that can only be read forward.
+///
+/// Reads 1 MB blocks and keeps the bytes; whenever the kept data doubles,
+/// everything before the last `lineCount` lines is dropped. The lines are
+/// copied out as raw bytes, like tailFromEnd does.
+///
+/// @param hFile     Pipe or device, or nullptr to read the previous stage or stdin.
+/// @param lineCount Number of lines to print.
+/// @param ctx       Execution context.
+/// @return BoolResult indicating success or failure.
+static BoolResult tailStream(HANDLE hFile, size_t lineCount, Execution::Executor::Context &ctx)
+{
+    constexpr DWORD BLOCK_SIZE = 1024 * 1024;
+
+    if (lineCount == 0)
+        return {true, {}};
+
+    // The previous stage may be a channel (built-in) or a pipe (external program)
+    auto readChunk = [&](char *data, DWORD capacity) -> DWORD
+    {
+        if (!hFile)
+            return Execution::Executor::readInput(ctx, data, capacity);
+
+        DWORD read = 0;
+        return ReadFile(hFile, data, capacity, &read, nullptr) ? read : 0;
+    };
+
+    std::string kept;
+    size_t trimAt = 4 * BLOCK_SIZE;
+
+    std::vector<char> block(BLOCK_SIZE);
+    DWORD bytesRead = 0;
+
+    while ((bytesRead = readChunk(block.data(), BLOCK_SIZE)) > 0)
+    {
+        kept.append(block.data(), bytesRead);
+
+        if (kept.size() >= trimAt)
+        {
+            kept.erase(0, lastLinesStart(kept, lineCount));
+            trimAt = std::max(trimAt, 2 * kept.size()); // long lines: trim less often
+        }
+    }
+
+    if (kept.empty())
+        return {true, {}};
+
+    const size_t start = lastLinesStart(kept, lineCount);
+    if (!Execution::Executor::writeBytes(ctx, kept.data() + start, kept.size() - start))
+        return {true, {}}; // the next stage stopped reading
+
+    if (kept.back() != '\n')
+        Execution::Executor::writeBytes(ctx, "\n", 1);
+
+    return {true, {}};
+}
+
+/// @brief Formats the progress line of a running 'cp' or 'mv'.
+/// @param command Command name shown first.
+/// @param p Counters reported by the copy engine.
+/// @return e.g. "cp: 12840 files, 412.5 MiB (3210 files/s, 103.1 MiB/s)".
+static std::wstring formatCopyProgress(const wchar_t *command, const FileIO::CopyEngine::Progress &p)
+{
+    const double mib = p.bytes / (1024.0 * 1024.0);
+    const double seconds = p.seconds > 0.0 ? p.seconds : 1.0;
+
+    wchar_t buffer[160];
+    swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%ls: %llu files, %.1f MiB (%.0f files/s, %.1f MiB/s)",
+             command, static_cast<unsigned long long>(p.files), mib, p.files / seconds, mib / seconds);
+
+    return buffer;
+}
+
+/// @brief Shows a running copy's progress on one console line.
+/// @param command Command name shown first.
+/// @param ctx Execution context; progress goes to its stderr, only if that is a console.
+/// @param shown Set once a line was shown (copies under half a second stay quiet).
+/// @param summary Receives the latest progress line.
+/// @return Callback for the copy engine.
+static FileIO::CopyEngine::ProgressCallback consoleProgress(const wchar_t *command, Execution::Executor::Context &ctx, bool &shown, std::wstring &summary)
+{
+    HANDLE err = (ctx.stderrHandle && ctx.stderrHandle != INVALID_HANDLE_VALUE) ? ctx.stderrHandle : GetStdHandle(STD_ERROR_HANDLE);
+    DWORD mode;
+    const bool onConsole = GetConsoleMode(err, &mode) != 0;
+
+    return [command, err, onConsole, &shown, &summary](const FileIO::CopyEngine::Progress &progress, bool final)
+    {
+        summary = formatCopyProgress(command, progress);
+
+        if (!onConsole || (!shown && progress.seconds < 0.5)) // quick copies stay quiet
+            return;
+
+        std::wstring line = L"\r" + summary + L"\x1b[K";
+        if (final)
+            line += L"\n";
+
+        DWORD written;
+        WriteConsoleW(err, line.c_str(), static_cast<DWORD>(line.size()), &written, nullptr);
+        shown = true;
+    };
 }
 
 /// @brief Formats a single file entry for `ls`.
-/// @param f WIN32_FIND_DATAW structure containing file info.
+/// @param f Directory entry.
 /// @param prefix String prefix (used for tree-like recursive output).
 /// @param flags Flags affecting output (e.g., verbose, recursive).
 /// @return Formatted string representing the file entry.
 static std::wstring formatLsEntry(
-    const WIN32_FIND_DATAW &f,
+    const FileIO::TreeWalker::Entry &f,
     const std::wstring &prefix,
     uint16_t flags)
 {
-    LARGE_INTEGER size;
-    size.LowPart = f.nFileSizeLow;
-    size.HighPart = f.nFileSizeHigh;
-
     if (flags & static_cast<uint16_t>(Flag::VERBOSE))
     {
         return prefix +
-               (f.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ? L"d " : L"- ") +
-               std::to_wstring(size.QuadPart) + L" " +
-               f.cFileName + L"\n";
+               (f.attributes & FILE_ATTRIBUTE_DIRECTORY ? L"d " : L"- ") +
+               std::to_wstring(f.size) + L" " +
+               f.name + L"\n";
     }
 
-    return prefix + f.cFileName + L"\n";
+    return prefix + f.name + L"\n";
 }
 
 // ---------------------------------------------------------------------------------------------------------------------------------
@@ -99,7 +316,7 @@ namespace FileIO
         case CommandType::LS:
         {
             std::wstring path = args.empty() ? L"." : args[0];
-            executeLS(path, flags, L"", ctx);
+            executeLS(path, flags, ctx);
             break;
         }
 
@@ -108,12 +325,10 @@ namespace FileIO
         {
             if (args.empty())
             {
-                writeOut(ctx.stderrHandle, L"Usage: rew <file>\n");
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::write(L"Usage: rew <file>\n");
+                Execution::Executor::writeError(ctx, L"Usage: rew <file> [file...]\n");
                 break;
             }
-            executeREW(args[0], ctx);
+            executeREW(args, ctx);
             break;
         }
 
@@ -122,9 +337,7 @@ namespace FileIO
         {
             if (args.empty())
             {
-                writeOut(ctx.stderrHandle, L"Usage: stats <file>\n");
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::write(L"Usage: stats <file>\n");
+                Execution::Executor::writeError(ctx, L"Usage: stats <file>\n");
                 break;
             }
             executeSTATS(args[0], ctx);
@@ -134,35 +347,31 @@ namespace FileIO
         // HEAD
         case CommandType::HEAD:
         {
-            if (!(flags & FLAG_COUNT) || (!ctx.pipelineEnabled && args.size() < 2))
+            const bool fromInput = hasInput(ctx) && args.size() < 2;
+
+            if (!(flags & (FLAG_COUNT | FLAG_BYTES)) || args.empty() || (!fromInput && args.size() < 2))
             {
-                writeOut(ctx.stderrHandle, L"Usage: head <file> -n <count>\n");
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::write(L"Usage: head <file> -n <count>\n");
+                Execution::Executor::writeError(ctx, L"Usage: head <file> (-n <lines> | -c <bytes>)\n");
                 break;
             }
 
             size_t count{};
             try
             {
-                count = std::stoull(args[1]);
+                count = std::stoull(args.back()); // reading input, only the count is given
             }
             catch (...)
             {
-                writeOut(ctx.stderrHandle, L"Invalid line count\n");
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::write(L"Invalid line count\n");
+                Execution::Executor::writeError(ctx, (flags & FLAG_BYTES) ? L"Invalid byte count\n" : L"Invalid line count\n");
                 break;
             }
 
-            std::wstring filename = ctx.pipelineEnabled ? L"" : args[0];
+            std::wstring filename = fromInput ? L"" : args[0]; // no file: read the previous stage or '< file'
 
-            auto res = executeHEAD(filename, count, ctx);
+            auto res = executeHEAD(filename, count, flags, ctx);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -171,35 +380,29 @@ namespace FileIO
         // TAIL
         case CommandType::TAIL:
         {
-            if (!(flags & FLAG_COUNT) || (!ctx.pipelineEnabled && args.size() < 2))
+            if (!(flags & FLAG_COUNT) || args.empty() || (!hasInput(ctx) && args.size() < 2))
             {
-                writeOut(ctx.stderrHandle, L"Usage: tail <file> -n <count>\n");
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::write(L"Usage: tail <file> -n <count>\n");
+                Execution::Executor::writeError(ctx, L"Usage: tail <file>... -n <count> [-f | -F]\n");
                 break;
             }
 
             size_t count{};
             try
             {
-                count = std::stoull(args[1]);
+                count = std::stoull(args.back()); // reading input, only the count is given
             }
             catch (...)
             {
-                writeOut(ctx.stderrHandle, L"Invalid line count\n");
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::write(L"Invalid line count\n");
+                Execution::Executor::writeError(ctx, L"Invalid line count\n");
                 break;
             }
 
-            std::wstring filename = ctx.pipelineEnabled ? L"" : args[0];
+            std::vector<std::wstring> filenames(args.begin(), args.end() - 1); // none: read the previous stage or '< file'
 
-            auto res = executeTAIL(filename, count, ctx);
+            auto res = executeTAIL(filenames, count, flags, ctx);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -211,9 +414,7 @@ namespace FileIO
             auto res = executeMKDIR(args.empty() ? L"" : args[0]);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -225,9 +426,7 @@ namespace FileIO
             auto res = executeRMDIR(args.empty() ? L"" : args[0]);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -239,9 +438,7 @@ namespace FileIO
             auto res = executeTOUCH(args.empty() ? L"" : args[0]);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -250,12 +447,10 @@ namespace FileIO
         // RM
         case CommandType::RM:
         {
-            auto res = executeRM(args.empty() ? L"" : args[0]);
+            auto res = executeRM(args.empty() ? L"" : args[0], flags);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -264,20 +459,27 @@ namespace FileIO
         // MV
         case CommandType::MV:
         {
+            if (flags & (FLAG_RESUME | FLAG_ROLLBACK))
+            {
+                auto res = executeMVPending(flags, ctx);
+                if (!res.ok())
+                {
+                    Execution::Executor::writeError(ctx, res.error.message);
+                }
+
+                break;
+            }
+
             if (args.size() < 2)
             {
-                writeOut(ctx.stderrHandle, L"Usage: mv <src> <dst>\n");
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::write(L"Usage: mv <src> <dst>\n");
+                Execution::Executor::writeError(ctx, L"Usage: mv <src> <dst>\n");
                 break;
             }
 
-            auto res = executeMV(args[0], args[1]);
+            auto res = executeMV(args[0], args[1], flags, ctx);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
@@ -288,27 +490,21 @@ namespace FileIO
         {
             if (args.size() < 2)
             {
-                writeOut(ctx.stderrHandle, L"Usage: cp <src> <dst>\n");
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::write(L"Usage: cp <src> <dst>\n");
+                Execution::Executor::writeError(ctx, L"Usage: cp <src> <dst>\n");
                 break;
             }
 
-            auto res = executeCP(args[0], args[1]);
+            auto res = executeCP(args[0], args[1], flags, ctx);
             if (!res.ok())
             {
-                writeOut(ctx.stderrHandle, res.error.message);
-                if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                    console::writeln(res.error.message);
+                Execution::Executor::writeError(ctx, res.error.message);
             }
 
             break;
         }
 
         default:
-            writeOut(ctx.stderrHandle, L"FileCommands: unsupported command\n");
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::write(L"FileCommands: unsupported command\n");
+            Execution::Executor::writeError(ctx, L"FileCommands: unsupported command\n");
             break;
         }
     }
@@ -318,192 +514,144 @@ namespace FileIO
     /// @return true if the path exists and is a directory, false otherwise.
     bool FileCommands::isDirectory(const std::wstring &path)
     {
-        DWORD attr = GetFileAttributesW(path.c_str());
+        DWORD attr = MetadataCache::instance().attributes(path);
         if (attr == INVALID_FILE_ATTRIBUTES)
             return false;
 
         return (attr & FILE_ATTRIBUTE_DIRECTORY) != 0;
     }
 
-    /// @brief Copies a single file from source to destination.
-    /// @param src Source file path.
-    /// @param dst Destination file path.
-    /// @return true if the copy succeeds, false otherwise.
-    bool FileCommands::copyFile(const std::wstring &src, const std::wstring &dst)
-    {
-        return CopyFileW(src.c_str(), dst.c_str(), FALSE) != 0; // overwrite allowed
-    }
-
-    /// @brief Recursively copies a directory from source to destination.
-    /// @param src Source directory.
-    /// @param dst Destination directory.
-    /// @return true if successful, false otherwise.
-    bool FileCommands::copyDirectory(const std::wstring &src, const std::wstring &dst)
+    /// @brief Reads and writes the contents of a file (rew command).
+    /// @param filename Path to the file.
+    /// @param ctx Execution context.
+    void FileCommands::executeREW(const std::vector<std::wstring> &files, Execution::Executor::Context &ctx)
     {
-        CreateDirectoryW(dst.c_str(), nullptr);
-
-        WIN32_FIND_DATAW ffd;
-        std::wstring search = src + L"\\*";
+        constexpr ULONGLONG VIEW_SIZE = 64ull * 1024 * 1024; // multiple of the 64 KB allocation granularity
+        constexpr DWORD BUFFER_SIZE = 1024 * 1024;
 
-        HANDLE hFind = FindFirstFileW(search.c_str(), &ffd);
-        if (hFind == INVALID_HANDLE_VALUE)
-            return false;
-
-        do
+        // File bytes are already UTF-8, which is what channels, pipes and files
+        // take: they are written straight from the mapped view without being
+        // copied or converted.
+        for (const auto &filename : files)
         {
-            if (wcscmp(ffd.cFileName, L".") == 0 ||
-                wcscmp(ffd.cFileName, L"..") == 0)
+            HANDLE hFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                Execution::Executor::writeError(ctx, L"rew: cannot open file '" + filename + L"'\n");
                 continue;
+            }
+
+            bool open = true; // false once the reader went away (e.g. 'head' finished)
 
-            std::wstring srcPath = src + L"\\" + ffd.cFileName;
-            std::wstring dstPath = dst + L"\\" + ffd.cFileName;
+            LARGE_INTEGER size{};
+            HANDLE hMap = nullptr;
 
-            if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+                hMap = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (hMap)
             {
-                if (!copyDirectory(srcPath, dstPath))
+                for (ULONGLONG offset = 0; open && offset < static_cast<ULONGLONG>(size.QuadPart); offset += VIEW_SIZE)
                 {
-                    FindClose(hFind);
-                    return false;
+                    ULONGLONG remaining = size.QuadPart - offset;
+                    SIZE_T length = static_cast<SIZE_T>(remaining < VIEW_SIZE ? remaining : VIEW_SIZE);
+
+                    void *view = MapViewOfFile(hMap, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                                               static_cast<DWORD>(offset), length);
+                    if (!view)
+                    {
+                        Execution::Executor::writeError(ctx, makeLastError(L"rew: " + filename).message);
+                        break;
+                    }
+
+                    open = Execution::Executor::writeBytes(ctx, static_cast<const char *>(view), length);
+                    UnmapViewOfFile(view);
                 }
+
+                CloseHandle(hMap);
             }
             else
             {
-                if (!CopyFileW(srcPath.c_str(), dstPath.c_str(), FALSE))
-                {
-                    FindClose(hFind);
-                    return false;
-                }
-            }
+                // Empty files and things that cannot be mapped (devices, NUL, ...)
+                std::vector<char> buffer(BUFFER_SIZE);
+                DWORD bytesRead;
 
-        } while (FindNextFileW(hFind, &ffd));
-
-        FindClose(hFind);
-        return true;
-    }
-
-    /// @brief Reads and writes the contents of a file (rew command).
-    /// @param filename Path to the file.
-    /// @param ctx Execution context.
-    void FileCommands::executeREW(const std::wstring &filename, Execution::Executor::Context &ctx)
-    {
-        HANDLE hFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-        if (hFile == INVALID_HANDLE_VALUE)
-        {
-            writeOut(ctx.stderrHandle, L"rew: cannot open file '" + filename + L"'\n");
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(L"rew: cannot open file '" + filename + L"'\n");
-            return;
-        }
-
-        char buffer[4096];
-        DWORD bytesRead;
-        std::wstring outBuffer;
-
-        while (ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, nullptr) && bytesRead > 0)
-        {
-            std::string chunk(buffer, bytesRead);
-            outBuffer += unicode::utf8_to_utf16(chunk);
-
-            if (outBuffer.size() > 16384) // 16 KB
-            {
-                writeOut(ctx.stdoutHandle, outBuffer);
-                outBuffer.clear();
+                while (open && ReadFile(hFile, buffer.data(), BUFFER_SIZE, &bytesRead, nullptr) && bytesRead > 0)
+                    open = Execution::Executor::writeBytes(ctx, buffer.data(), bytesRead);
             }
-        }
 
-        if (!outBuffer.empty())
-        {
-            writeOut(ctx.stdoutHandle, outBuffer);
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(outBuffer);
-        }
+            CloseHandle(hFile);
 
-        CloseHandle(hFile);
+            if (!open)
+                return;
+        }
     }
 
     /// @brief Lists the contents of a directory (ls command).
     /// @param pathStr Path to list (default is ".").
     /// @param flags Flags affecting output (e.g., recursive, all, verbose).
-    /// @param prefix Prefix used for tree-like recursive display.
     /// @param ctx Execution context.
     void FileCommands::executeLS(
         const std::wstring &pathStr,
         uint16_t flags,
-        const std::wstring &prefix,
         Execution::Executor::Context &ctx)
     {
         std::wstring path = pathStr.empty() ? L"." : pathStr;
-        std::wstring searchPath = path + L"\\*";
+        const bool recursive = flags & static_cast<uint16_t>(Flag::RECURSIVE);
 
-        WIN32_FIND_DATAW ffd;
-        HANDLE hFind = FindFirstFileW(searchPath.c_str(), &ffd);
+        std::wstring outBuffer;
 
-        if (hFind == INVALID_HANDLE_VALUE)
+        auto flush = [&]() -> bool
         {
-            writeOut(ctx.stderrHandle, L"ls: cannot access '" + path + L"'\n");
+            bool open = outBuffer.empty() || Execution::Executor::writeOutput(ctx, outBuffer);
+            outBuffer.clear();
+            return open; // false once the next stage stopped reading
+        };
 
-            if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                console::writeln(L"ls: cannot access '" + path + L"'\n");
-            return;
-        }
-
-        std::vector<WIN32_FIND_DATAW> entries;
-        do
+        if (!recursive)
         {
-            entries.push_back(ffd);
-        } while (FindNextFileW(hFind, &ffd));
+            // A single directory comes from the metadata cache, so an unchanged one is not read again
+            auto listing = MetadataCache::instance().list(path);
+            if (!listing)
+            {
+                Execution::Executor::writeError(ctx, L"ls: cannot access '" + path + L"'\n");
+                return;
+            }
 
-        FindClose(hFind);
+            for (const auto &entry : *listing)
+            {
+                if (!(flags & static_cast<uint16_t>(Flag::ALL)) && (entry.attributes & FILE_ATTRIBUTE_HIDDEN))
+                    continue;
 
-        std::vector<WIN32_FIND_DATAW> visible;
-        for (const auto &e : entries)
-        {
-            std::wstring name = e.cFileName;
+                outBuffer += formatLsEntry(entry, L"", flags);
 
-            if (name == L"." || name == L"..")
-                continue;
-            if (!(flags & static_cast<uint16_t>(Flag::ALL)) &&
-                (e.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN))
-                continue;
+                if (outBuffer.size() >= 16384 && !flush()) // 16 KB
+                    return;
+            }
 
-            visible.push_back(e);
+            flush();
+            return;
         }
 
-        std::wstring outBuffer;
-
-        for (size_t i = 0; i < visible.size(); ++i)
-        {
-            const auto &f = visible[i];
-            std::wstring name = f.cFileName;
+        TreeWalker walker(flags & static_cast<uint16_t>(Flag::ALL));
 
-            bool isLast = (i == visible.size() - 1);
-
-            std::wstring treePrefix = prefix;
-            if (flags & static_cast<uint16_t>(Flag::RECURSIVE))
-                treePrefix += isLast ? L"|___" : L"|---";
-
-            outBuffer += formatLsEntry(f, treePrefix, flags);
-
-            if ((flags & static_cast<uint16_t>(Flag::RECURSIVE)) &&
-                (f.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        walker.walk(
+            path, true,
+            [&](const TreeWalker::Entry &entry, const std::wstring &prefix, bool last)
             {
-                if (f.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
-                    continue;
+                outBuffer += formatLsEntry(entry, prefix + (last ? L"|___" : L"|---"), flags);
 
-                std::wstring newPrefix = prefix;
-                newPrefix += isLast ? L"    " : L"|   ";
-
-                executeLS(path + L"\\" + name, flags, newPrefix, ctx);
-            }
-        }
-
-        if (!outBuffer.empty())
-        {
-            writeOut(ctx.stdoutHandle, outBuffer);
+                return outBuffer.size() < 16384 || flush(); // 16 KB
+            },
+            [&](const std::wstring &dir)
+            {
+                flush();
+                Execution::Executor::writeError(ctx, L"ls: cannot access '" + dir + L"'\n");
+            },
+            flush); // the walk is waiting on a directory: show what we have
 
-            if (!ctx.pipelineEnabled && !ctx.redirectionEnabled)
-                console::writeln(outBuffer);
-        }
+        flush();
     }
 
     /// @brief Prints file statistics (lines, words, bytes, size, timestamps, attributes).
@@ -514,7 +662,7 @@ namespace FileIO
         HANDLE hFile = CreateFileW(
             filename.c_str(),
             GENERIC_READ,
-            FILE_SHARE_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE, // logs are usually still being written
             nullptr,
             OPEN_EXISTING,
             FILE_ATTRIBUTE_NORMAL,
@@ -522,51 +670,24 @@ namespace FileIO
 
         if (hFile == INVALID_HANDLE_VALUE)
         {
-            writeOut(ctx.stderrHandle, L"stats: cannot open file '" + filename + L"'\n");
-
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::write(L"stats: cannot open file '" + filename + L"'\n");
+            Execution::Executor::writeError(ctx, L"stats: cannot open file '" + filename + L"'\n");
             return;
         }
 
-        DWORD lineCount = 0;
-        DWORD wordCount = 0;
-        DWORD byteCount = 0;
-
-        BYTE buffer[4096];
-        DWORD bytesRead = 0;
-        bool inWord = false;
-
-        while (ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, nullptr) &&
-               bytesRead > 0)
+        BY_HANDLE_FILE_INFORMATION info;
+        if (!GetFileInformationByHandle(hFile, &info))
         {
-            byteCount += bytesRead;
-
-            for (DWORD i = 0; i < bytesRead; ++i)
-            {
-                BYTE c = buffer[i];
-
-                if (c == '\n')
-                    ++lineCount;
+            CloseHandle(hFile);
+            Execution::Executor::writeError(ctx, L"stats: failed to get file information\n");
 
-                if (isspace(c))
-                    inWord = false;
-                else if (!inWord)
-                {
-                    ++wordCount;
-                    inWord = true;
-                }
-            }
+            return;
         }
 
-        BY_HANDLE_FILE_INFORMATION info;
-        if (!GetFileInformationByHandle(hFile, &info))
+        auto counted = StatsCache::count(hFile, info); // logs that only grew count just their new tail
+        if (!counted.ok())
         {
             CloseHandle(hFile);
-            writeOut(ctx.stderrHandle, L"stats: failed to get file information\n");
-
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::write(L"stats: failed to get file information\n");
+            Execution::Executor::writeError(ctx, counted.error.message);
 
             return;
         }
@@ -580,9 +701,9 @@ namespace FileIO
         std::wstring out;
         out.reserve(512);
 
-        out += L"Lines              : " + std::to_wstring(lineCount) + L"\n";
-        out += L"Words              : " + std::to_wstring(wordCount) + L"\n";
-        out += L"Bytes              : " + std::to_wstring(byteCount) + L"\n";
+        out += L"Lines              : " + std::to_wstring(counted.value.lines) + L"\n";
+        out += L"Words              : " + std::to_wstring(counted.value.words) + L"\n";
+        out += L"Bytes              : " + std::to_wstring(counted.value.bytes) + L"\n";
         out += L"File size          : " + std::to_wstring(size.QuadPart) + L" bytes\n";
         out += L"Attributes         : " +
                helper::attributesToWSTRING(info.dwFileAttributes) + L"\n";
@@ -595,97 +716,139 @@ namespace FileIO
 
         if (!out.empty())
         {
-            writeOut(ctx.stdoutHandle, out);
-
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(out);
+            Execution::Executor::writeOutput(ctx, out);
         }
     }
 
-    /// @brief Outputs the first N lines of a file (head command).
-    /// @param filename File path.
-    /// @param lineCount Number of lines to display.
+    /// @brief Outputs the first N lines or bytes of a file (head command).
+    ///
+    /// Disk files are mapped and scanned for the N-th line break in place;
+    /// pipes and the previous stage are read in 1 MB blocks. Either way the
+    /// prefix is written out as raw bytes, and nothing past it is read.
+    ///
+    /// @param filename File path; empty to read the previous stage or stdin.
+    /// @param count Number of lines (or bytes with -c) to display.
+    /// @param flags -c counts bytes instead of lines.
     /// @param ctx Execution context.
     /// @return BoolResult indicating success or failure.
-    BoolResult FileCommands::executeHEAD(const std::wstring &filename, size_t lineCount, Execution::Executor::Context &ctx)
+    BoolResult FileCommands::executeHEAD(const std::wstring &filename, size_t count, uint16_t flags, Execution::Executor::Context &ctx)
     {
-        HANDLE hFile = INVALID_HANDLE_VALUE;
+        constexpr ULONGLONG VIEW_SIZE = 64ull * 1024 * 1024; // multiple of the 64 KB allocation granularity
+        constexpr DWORD BUFFER_SIZE = 1024 * 1024;
+
+        const bool byBytes = (flags & FLAG_BYTES) != 0;
+
+        if (count == 0)
+            return {true, {}};
 
-        if (filename.empty() && ctx.pipelineEnabled)
+        HANDLE hFile = nullptr; // nullptr: read the previous stage (see readChunk)
+        const bool fromInput = filename.empty();
+
+        if (fromInput)
         {
-            hFile = ctx.stdinHandle;   // READ FROM PIPE
+            // '< file' gives a disk file as stdin: that one can be mapped too
+            HANDLE stdinHandle = (ctx.stdinHandle && ctx.stdinHandle != INVALID_HANDLE_VALUE) ? ctx.stdinHandle : GetStdHandle(STD_INPUT_HANDLE);
+            if (!ctx.inChannel && GetFileType(stdinHandle) == FILE_TYPE_DISK)
+                hFile = stdinHandle;
         }
         else
         {
             hFile = CreateFileW(
                 filename.c_str(),
                 GENERIC_READ,
-                FILE_SHARE_READ,
+                FILE_SHARE_READ | FILE_SHARE_WRITE,
                 nullptr,
                 OPEN_EXISTING,
-                FILE_ATTRIBUTE_NORMAL,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
                 nullptr);
+
+            if (hFile == INVALID_HANDLE_VALUE)
+                return {false, makeLastError(L"head: " + filename)};
         }
 
-        if (hFile == INVALID_HANDLE_VALUE)
+        size_t remaining = count; // lines or bytes still to print
+
+        // Passes the wanted part of a block through; false once done or nobody reads any more
+        auto take = [&](const char *data, size_t size) -> bool
         {
-            writeOut(ctx.stderrHandle, L"head: cannot open file\n");
+            size_t length = size;
 
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(L"head: cannot open file\n");
+            if (byBytes)
+            {
+                if (length > remaining)
+                    length = remaining;
+                remaining -= length;
+            }
+            else if (const char *newline = bytescan::findNth(data, size, '\n', remaining))
+            {
+                length = static_cast<size_t>(newline - data) + 1;
+            }
 
-            return {false, makeLastError(L"head")};
-        }
+            if (length > 0 && !Execution::Executor::writeBytes(ctx, data, length))
+                return false;
 
-        BYTE buffer[4096];
-        DWORD bytesRead = 0;
-        size_t currentLine = 0;
-        bool done = false;
-        std::wstring outBuffer;
-        std::wstring currentLineStr;
+            return remaining > 0;
+        };
 
-        while (!done && ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, nullptr) && bytesRead > 0)
-        {
-            std::string chunk(reinterpret_cast<const char *>(buffer), bytesRead);
-            std::wstring wchunk = unicode::utf8_to_utf16(chunk);
+        LARGE_INTEGER size{};
+        HANDLE hMap = nullptr;
 
-            for (wchar_t ch : wchunk)
-            {
-                currentLineStr.push_back(ch);
-                if (ch == L'\n')
-                {
-                    outBuffer += currentLineStr;
-                    currentLineStr.clear();
-                    ++currentLine;
+        if (hFile && GetFileType(hFile) == FILE_TYPE_DISK && GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+            hMap = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
 
-                    if (outBuffer.size() > 16384) // 16 KB buffer
-                    {
-                        writeOut(ctx.stdoutHandle, outBuffer);
-                        outBuffer.clear();
-                    }
+        Error error;
 
-                    if (currentLine >= lineCount)
-                    {
-                        done = true;
-                        break;
-                    }
+        if (hMap)
+        {
+            // Views are mapped one after another, and only until the prefix ends
+            bool more = true;
+            for (ULONGLONG offset = 0; more && offset < static_cast<ULONGLONG>(size.QuadPart); offset += VIEW_SIZE)
+            {
+                ULONGLONG left = size.QuadPart - offset;
+                SIZE_T length = static_cast<SIZE_T>(left < VIEW_SIZE ? left : VIEW_SIZE);
+
+                void *view = MapViewOfFile(hMap, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                                           static_cast<DWORD>(offset), length);
+                if (!view)
+                {
+                    error = makeLastError(L"head");
+                    break;
                 }
+
+                more = take(static_cast<const char *>(view), length);
+                UnmapViewOfFile(view);
             }
+
+            CloseHandle(hMap);
         }
+        else if (!hFile || GetFileType(hFile) != FILE_TYPE_DISK || size.QuadPart > 0)
+        {
+            // Pipes, devices, and files that cannot be mapped
 
-        if (!currentLineStr.empty())
-            outBuffer += currentLineStr;
+            // The previous stage may be a channel (built-in) or a pipe (external program)
+            auto readChunk = [&](char *data, DWORD capacity) -> DWORD
+            {
+                if (!hFile)
+                    return Execution::Executor::readInput(ctx, data, capacity);
 
-        if (!outBuffer.empty())
-        {
-            writeOut(ctx.stdoutHandle, outBuffer);
+                DWORD read = 0;
+                return ReadFile(hFile, data, capacity, &read, nullptr) ? read : 0;
+            };
+
+            std::vector<char> buffer(BUFFER_SIZE);
+            DWORD bytesRead = 0;
 
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(outBuffer);
+            while ((bytesRead = readChunk(buffer.data(), BUFFER_SIZE)) > 0 && take(buffer.data(), bytesRead))
+            {
+            }
         }
 
-        if (!(filename.empty() && ctx.pipelineEnabled))
+        if (!fromInput)
             CloseHandle(hFile);
+
+        if (error.hasError())
+            return {false, error};
+
         return {true, {}};
     }
 
@@ -709,17 +872,46 @@ namespace FileIO
             return {false, makeLastError(L"touch")};
 
         CloseHandle(hFile);
+        MetadataCache::instance().invalidate(wFilename);
         return {true, {}};
     }
 
-    /// @brief Deletes a file (rm command).
-    /// @param path File path.
+    /// @brief Deletes a file, or a directory tree with -r (rm command).
+    /// @param path File or directory path.
+    /// @param flags -r allows directories.
     /// @return BoolResult indicating success or failure.
-    BoolResult FileCommands::executeRM(const std::wstring &path)
+    BoolResult FileCommands::executeRM(const std::wstring &path, uint16_t flags)
     {
-        if (!DeleteFileW(path.c_str()))
+        DWORD attr = GetFileAttributesW(path.c_str());
+        if (attr == INVALID_FILE_ATTRIBUTES)
             return {false, makeLastError(L"rm")};
 
+        const bool directory = (attr & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        const bool link = (attr & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+
+        if (directory && link)
+        {
+            // A junction or directory symlink: remove the link, never what it points to
+            if (!RemoveDirectoryW(path.c_str()))
+                return {false, makeLastError(L"rm")};
+        }
+        else if (directory)
+        {
+            if (!(flags & FLAG_RECURSIVE))
+                return {false, {0, L"rm: '" + path + L"' is a directory (use rm -r)"}};
+
+            MetadataCache::instance().invalidate(path); // release watches inside the tree first
+
+            auto res = Purger::instance().remove(path);
+            if (!res.ok())
+                return res;
+        }
+        else if (!DeleteFileW(path.c_str()))
+        {
+            return {false, makeLastError(L"rm")};
+        }
+
+        MetadataCache::instance().invalidate(path);
         return {true, {}};
     }
 
@@ -733,6 +925,7 @@ namespace FileIO
                 nullptr))
             return {false, makeLastError(L"mkdir")};
 
+        MetadataCache::instance().invalidate(dirname);
         return {true, {}};
     }
 
@@ -741,18 +934,23 @@ namespace FileIO
     /// @return BoolResult indicating success or failure.
     BoolResult FileCommands::executeRMDIR(const std::wstring &dirname)
     {
+        MetadataCache::instance().invalidate(dirname); // its own watch would leave it delete-pending
+
         if (!RemoveDirectoryW(
                 dirname.c_str()))
             return {false, makeLastError(L"rmdir")};
 
+        MetadataCache::instance().invalidate(dirname);
         return {true, {}};
     }
 
     /// @brief Moves a file or directory to a new location (mv command).
     /// @param src Source path.
     /// @param dst Destination path.
+    /// @param flags Flags affecting output (-v prints a summary of a copy between volumes).
+    /// @param ctx Execution context.
     /// @return BoolResult indicating success or failure.
-    BoolResult FileCommands::executeMV(const std::wstring &src, const std::wstring &dst)
+    BoolResult FileCommands::executeMV(const std::wstring &src, const std::wstring &dst, uint16_t flags, Execution::Executor::Context &ctx)
     {
         std::wstring wSrc = src;
         std::wstring wDst = dst;
@@ -762,29 +960,78 @@ namespace FileIO
             wDst += helper::basename(wSrc);
         }
 
-        if (!MoveFileExW(
-                wSrc.c_str(),
-                wDst.c_str(),
-                MOVEFILE_REPLACE_EXISTING |
-                    MOVEFILE_COPY_ALLOWED))
+        bool shown = false;
+        std::wstring summary;
+
+        MetadataCache::instance().invalidate(wSrc); // release watches inside the tree before it is renamed
+
+        auto res = MoveEngine::move(wSrc, wDst, consoleProgress(L"mv", ctx, shown, summary));
+
+        MetadataCache::instance().invalidate(wSrc);
+        MetadataCache::instance().invalidate(wDst);
+
+        if ((flags & FLAG_VERBOSE) && !shown && !summary.empty())
+            Execution::Executor::writeOutput(ctx, summary + L"\n");
+
+        return res;
+    }
+
+    /// @brief Resumes (--resume) or rolls back (--rollback) the moves an interrupted 'mv' left in its journal.
+    /// @param flags --resume or --rollback.
+    /// @param ctx Execution context.
+    /// @return BoolResult with the first failure; the other moves are still tried.
+    BoolResult FileCommands::executeMVPending(uint16_t flags, Execution::Executor::Context &ctx)
+    {
+        const auto moves = MoveEngine::pending();
+        if (moves.empty())
         {
-            return {false, makeLastError(L"mv")};
+            Execution::Executor::writeOutput(ctx, L"mv: no interrupted moves\n");
+            return {true, {}};
         }
 
-        return {true, {}};
+        BoolResult result{true, {}};
+
+        for (const auto &move : moves)
+        {
+            bool shown = false;
+            std::wstring summary;
+
+            MetadataCache::instance().invalidate(move.src);
+            MetadataCache::instance().invalidate(move.dst);
+
+            auto res = (flags & FLAG_ROLLBACK) ? MoveEngine::rollback(move)
+                                               : MoveEngine::resume(move, consoleProgress(L"mv", ctx, shown, summary));
+
+            MetadataCache::instance().invalidate(move.src);
+            MetadataCache::instance().invalidate(move.dst);
+
+            if (!res.ok())
+            {
+                if (result.ok())
+                    result = res;
+                continue;
+            }
+
+            Execution::Executor::writeOutput(ctx, ((flags & FLAG_ROLLBACK) ? L"mv: rolled back '" : L"mv: moved '") +
+                                                      move.src + L"' -> '" + move.dst + L"'\n");
+        }
+
+        return result;
     }
 
     /// @brief Copies a file or directory (cp command).
     /// @param src Source path.
     /// @param dst Destination path.
+    /// @param flags Flags affecting output (-v prints a summary).
+    /// @param ctx Execution context.
     /// @return BoolResult indicating success or failure.
-    BoolResult FileCommands::executeCP(const std::wstring &src, const std::wstring &dst)
+    BoolResult FileCommands::executeCP(const std::wstring &src, const std::wstring &dst, uint16_t flags, Execution::Executor::Context &ctx)
     {
         std::wstring wSrc = src;
         std::wstring wDst = dst;
-        DWORD attr = GetFileAttributesW(wSrc.c_str());
+        DWORD attr = MetadataCache::instance().attributes(wSrc);
         if (attr == INVALID_FILE_ATTRIBUTES)
-            return {false, makeLastError(L"cp")};
+            return {false, {ERROR_FILE_NOT_FOUND, L"cp: cannot stat '" + wSrc + L"'"}};
 
         if (isDirectory(wDst))
         {
@@ -792,112 +1039,107 @@ namespace FileIO
             wDst += helper::basename(wSrc);
         }
 
-        bool ok;
-        if (attr & FILE_ATTRIBUTE_DIRECTORY)
-            ok = copyDirectory(wSrc, wDst);
+        MetadataCache::instance().invalidate(wDst);
+
+        bool shown = false;
+        std::wstring summary;
+
+        BoolResult res;
+
+        if (!(attr & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            res = CopyEngine::copyFile(wSrc, wDst, consoleProgress(L"cp", ctx, shown, summary));
+        }
         else
-            ok = copyFile(wSrc, wDst);
+        {
+            CopyEngine engine;
+            res = engine.copyTree(wSrc, wDst, consoleProgress(L"cp", ctx, shown, summary));
+        }
 
-        if (!ok)
-            return {false, makeLastError(L"cp")};
+        if ((flags & FLAG_VERBOSE) && !shown && !summary.empty()) // small single files report nothing
+            Execution::Executor::writeOutput(ctx, summary + L"\n");
 
-        return {true, {}};
+        return res;
     }
 
-    /// @brief Outputs the last N lines of a file (tail command).
-    /// @param filename File path.
+    /// @brief Outputs the last N lines of files (tail command), then follows them with -f / -F.
+    /// @param filenames File paths; empty to read the previous stage or stdin.
     /// @param lineCount Number of lines to display.
+    /// @param flags -f / -F select follow mode.
     /// @param ctx Execution context.
     /// @return BoolResult indicating success or failure.
-    BoolResult FileCommands::executeTAIL(const std::wstring &filename, size_t lineCount, Execution::Executor::Context &ctx)
+    BoolResult FileCommands::executeTAIL(const std::vector<std::wstring> &filenames, size_t lineCount, uint16_t flags, Execution::Executor::Context &ctx)
     {
-        HANDLE hFile = INVALID_HANDLE_VALUE;
-
-        if (filename.empty() && ctx.pipelineEnabled)
+        if (filenames.empty())
         {
-            hFile = ctx.stdinHandle;
+            // '< file' gives a disk file as stdin: that one can be read from the end too
+            HANDLE stdinHandle = (ctx.stdinHandle && ctx.stdinHandle != INVALID_HANDLE_VALUE) ? ctx.stdinHandle : GetStdHandle(STD_INPUT_HANDLE);
+            if (!ctx.inChannel && GetFileType(stdinHandle) == FILE_TYPE_DISK)
+                return tailFromEnd(stdinHandle, lineCount, ctx);
+
+            return tailStream(nullptr, lineCount, ctx); // READ FROM PIPE
         }
-        else
+
+        const bool follow = (flags & (FLAG_FORCE | FLAG_FOLLOW)) != 0;
+        FileIO::TailFollower follower((flags & FLAG_FOLLOW) != 0, ctx);
+
+        for (size_t i = 0; i < filenames.size(); ++i)
         {
-            hFile = CreateFileW(
+            const std::wstring &filename = filenames[i];
+
+            if (filenames.size() > 1)
+            {
+                if (!Execution::Executor::writeOutput(ctx, (i ? L"\n==> " : L"==> ") + filename + L" <==\n"))
+                    return {true, {}}; // the next stage stopped reading
+            }
+
+            HANDLE hFile = CreateFileW(
                 filename.c_str(),
                 GENERIC_READ,
-                FILE_SHARE_READ,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, // logs are usually still being written, and rotated
                 nullptr,
                 OPEN_EXISTING,
                 FILE_ATTRIBUTE_NORMAL,
                 nullptr);
-        }
-
-        if (hFile == INVALID_HANDLE_VALUE)
-        {
-            writeOut(ctx.stderrHandle, L"tail: cannot open file\n");
-
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(L"tail: cannot open file\n");
-
-            return {false, makeLastError(L"tail")};
-        }
-
-        BYTE buffer[4096];
-        DWORD bytesRead = 0;
-
-        std::deque<std::wstring> lineBuffer;
-        std::wstring currentLine;
-
-        while (ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, nullptr) && bytesRead > 0)
-        {
-            std::string chunk(reinterpret_cast<const char *>(buffer), bytesRead);
-            std::wstring wchunk = unicode::utf8_to_utf16(chunk);
 
-            for (wchar_t ch : wchunk)
+            if (hFile == INVALID_HANDLE_VALUE)
             {
-                if (ch == L'\n')
-                {
-                    lineBuffer.push_back(currentLine);
-                    if (lineBuffer.size() > lineCount)
-                        lineBuffer.pop_front();
+                auto err = makeLastError(L"tail: " + filename);
+                Execution::Executor::writeError(ctx, err.message);
 
-                    currentLine.clear();
-                }
-                else if (ch != L'\r')
-                {
-                    currentLine.push_back(ch);
-                }
+                if (follow)
+                    follower.add(filename, INVALID_HANDLE_VALUE, 0); // -F waits for it to appear
+                continue;
             }
-        }
-
-        if (!currentLine.empty())
-        {
-            lineBuffer.push_back(currentLine);
-            if (lineBuffer.size() > lineCount)
-                lineBuffer.pop_front();
-        }
-
-        if (!(filename.empty() && ctx.pipelineEnabled))
-            CloseHandle(hFile);
 
-        std::wstring outBuffer;
-        for (const auto &line : lineBuffer)
-        {
-            outBuffer += line + L"\n";
-
-            // 16 KB
-            if (outBuffer.size() > 16384)
+            if (GetFileType(hFile) != FILE_TYPE_DISK)
             {
-                writeOut(ctx.stdoutHandle, outBuffer);
-                outBuffer.clear();
+                // Devices and named pipes can only be read forward, and not followed
+                auto res = tailStream(hFile, lineCount, ctx);
+                CloseHandle(hFile);
+                if (!res.ok())
+                    Execution::Executor::writeError(ctx, res.error.message);
+                continue;
             }
-        }
 
-        if (!outBuffer.empty())
-        {
-            writeOut(ctx.stdoutHandle, outBuffer);
+            uint64_t end = 0;
+            auto res = tailFromEnd(hFile, lineCount, ctx, follow ? &end : nullptr);
+            if (!res.ok())
+            {
+                Execution::Executor::writeError(ctx, res.error.message);
+                CloseHandle(hFile);
+                continue;
+            }
 
-            if (ctx.pipelineEnabled == false && ctx.redirectionEnabled == false)
-                console::writeln(outBuffer);
+            if (follow)
+                follower.add(filename, hFile, end);
+            else
+                CloseHandle(hFile);
         }
 
+        if (follow)
+            follower.run();
+
         return {true, {}};
     }
-}
\ No newline at end of file
+}
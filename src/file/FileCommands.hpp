@@ -64,19 +64,21 @@ namespace FileIO
         /**
          * @brief Lists the contents of a directory.
          *
+         * With -r the tree is listed by a parallel TreeWalker and printed in
+         * tree order while the walk is still running.
+         *
          * @param pathStr Directory path (default is current directory).
          * @param flags Bitwise flags (e.g., recursive, all, verbose).
-         * @param prefix Prefix for recursive tree-like output.
          * @param ctx Execution context.
          */
-        static void executeLS(const std::wstring &pathStr, uint16_t flags, const std::wstring &prefix, Execution::Executor::Context &ctx);
+        static void executeLS(const std::wstring &pathStr, uint16_t flags, Execution::Executor::Context &ctx);
 
         /**
-         * @brief Reads and writes the contents of a file.
-         * @param filename File path.
+         * @brief Writes the contents of one or more files, one after another.
+         * @param files File paths.
          * @param ctx Execution context.
          */
-        static void executeREW(const std::wstring &filename, Execution::Executor::Context &ctx);
+        static void executeREW(const std::vector<std::wstring> &files, Execution::Executor::Context &ctx);
 
         /**
          * @brief Prints file statistics (lines, words, bytes, size, timestamps, attributes).
@@ -93,38 +95,28 @@ namespace FileIO
         static bool isDirectory(const std::wstring &path);
 
         /**
-         * @brief Copies a single file from source to destination.
-         * @param src Source file path.
-         * @param dst Destination file path.
-         * @return true if copy succeeds, false otherwise.
-         */
-        static bool copyFile(const std::wstring &src, const std::wstring &dst);
-
-        /**
-         * @brief Recursively copies a directory.
-         * @param src Source directory path.
-         * @param dst Destination directory path.
-         * @return true if copy succeeds, false otherwise.
-         */
-        static bool copyDirectory(const std::wstring &src, const std::wstring &dst);
-
-        /**
-         * @brief Outputs the first N lines of a file (head command).
-         * @param filename File path.
-         * @param lineCount Number of lines to output.
+         * @brief Outputs the first N lines or bytes of a file (head command).
+         * @param filename File path; empty to read the previous stage or stdin.
+         * @param count Number of lines (or bytes with -c) to output.
+         * @param flags -c counts bytes instead of lines.
          * @param ctx Execution context.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeHEAD(const std::wstring &filename, size_t lineCount, Execution::Executor::Context &ctx);
+        static BoolResult executeHEAD(const std::wstring &filename, size_t count, uint16_t flags, Execution::Executor::Context &ctx);
 
         /**
-         * @brief Outputs the last N lines of a file (tail command).
-         * @param filename File path.
+         * @brief Outputs the last N lines of files (tail command).
+         *
+         * With several files each gets a '==> name <==' header. With -f the
+         * files are then followed until Ctrl+C; -F follows them by name.
+         *
+         * @param filenames File paths; empty to read the previous stage or stdin.
          * @param lineCount Number of lines to output.
+         * @param flags -f / -F select follow mode.
          * @param ctx Execution context.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeTAIL(const std::wstring &filename, size_t lineCount, Execution::Executor::Context &ctx);
+        static BoolResult executeTAIL(const std::vector<std::wstring> &filenames, size_t lineCount, uint16_t flags, Execution::Executor::Context &ctx);
 
         /**
          * @brief Creates a new empty file (touch command).
@@ -134,11 +126,16 @@ namespace FileIO
         static BoolResult executeTOUCH(const std::wstring &filename);
 
         /**
-         * @brief Deletes a file (rm command).
-         * @param path File path.
+         * @brief Deletes a file, or a directory tree with -r (rm command).
+         *
+         * A tree is renamed out of the way at once and deleted by the
+         * Purger in the background. Links are removed, never followed.
+         *
+         * @param path File or directory path.
+         * @param flags -r allows directories.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeRM(const std::wstring &path);
+        static BoolResult executeRM(const std::wstring &path, uint16_t flags);
 
         /**
          * @brief Creates a new directory (mkdir command).
@@ -156,19 +153,39 @@ namespace FileIO
 
         /**
          * @brief Moves a file or directory to a new location (mv command).
+         *
+         * Between volumes the source is copied by a MoveEngine, which
+         * journals the move so it can be resumed or rolled back.
+         *
          * @param src Source path.
          * @param dst Destination path.
+         * @param flags Flags affecting output (-v prints a summary of a copy).
+         * @param ctx Execution context.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeMV(const std::wstring &src, const std::wstring &dst);
+        static BoolResult executeMV(const std::wstring &src, const std::wstring &dst, uint16_t flags, Execution::Executor::Context &ctx);
+
+        /**
+         * @brief Resumes or rolls back the moves left in the journal (mv --resume / --rollback).
+         * @param flags --resume or --rollback.
+         * @param ctx Execution context.
+         * @return BoolResult with the first failure.
+         */
+        static BoolResult executeMVPending(uint16_t flags, Execution::Executor::Context &ctx);
 
         /**
          * @brief Copies a file or directory (cp command).
+         *
+         * Directories and large files are copied by a parallel CopyEngine,
+         * which shows its progress on the console while it runs.
+         *
          * @param src Source path.
          * @param dst Destination path.
+         * @param flags Flags affecting output (-v prints a summary).
+         * @param ctx Execution context.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeCP(const std::wstring &src, const std::wstring &dst);
+        static BoolResult executeCP(const std::wstring &src, const std::wstring &dst, uint16_t flags, Execution::Executor::Context &ctx);
 
     };
 }
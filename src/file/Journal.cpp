@@ -0,0 +1,132 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\Journal.cpp
+// PURPOSE: Small line-based journals shared by esh instances.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <string>
+
+#include <windows.h>
+
+#include "../headers/Unicode.hpp"
+#include "../platform/AppDataPath.hpp"
+#include "../platform/FileSystem.hpp"
+#include "Journal.hpp"
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    Journal::Journal(const std::wstring &name)
+        : m_path((Platform::getBasePath() / name).wstring())
+    {
+        m_mutex = CreateMutexW(nullptr, FALSE, (L"Local\\esh." + name).c_str());
+    }
+
+    Journal::~Journal()
+    {
+        if (m_mutex)
+            CloseHandle(m_mutex);
+    }
+
+    std::vector<std::wstring> Journal::load() const
+    {
+        std::vector<std::wstring> entries;
+
+        HANDLE hFile = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return entries;
+
+        std::string data;
+        char buffer[4096];
+        DWORD read = 0;
+
+        while (ReadFile(hFile, buffer, sizeof(buffer), &read, nullptr) && read > 0)
+            data.append(buffer, read);
+
+        CloseHandle(hFile);
+
+        size_t start = 0;
+        while (start < data.size())
+        {
+            size_t end = data.find('\n', start);
+            if (end == std::string::npos)
+                break; // torn last line
+
+            if (end > start)
+                entries.push_back(unicode::utf8_to_utf16(data.substr(start, end - start)));
+
+            start = end + 1;
+        }
+
+        return entries;
+    }
+
+    bool Journal::save(const std::vector<std::wstring> &entries) const
+    {
+        if (entries.empty())
+            return DeleteFileW(m_path.c_str()) || GetLastError() == ERROR_FILE_NOT_FOUND;
+
+        std::string data;
+        for (const auto &entry : entries)
+        {
+            data += unicode::utf16_to_utf8(entry);
+            data += '\n';
+        }
+
+        return Platform::replaceFile(m_path, data, true);
+    }
+
+    bool Journal::add(const std::wstring &entry) const
+    {
+        Lock lock(*this);
+
+        auto entries = load();
+        entries.push_back(entry);
+        return save(entries);
+    }
+
+    void Journal::remove(const std::wstring &entry) const
+    {
+        Lock lock(*this);
+
+        auto entries = load();
+        auto it = std::find(entries.begin(), entries.end(), entry);
+        if (it == entries.end())
+            return;
+
+        entries.erase(it);
+        save(entries);
+    }
+
+    bool Journal::replace(const std::wstring &from, const std::wstring &to) const
+    {
+        Lock lock(*this);
+
+        auto entries = load();
+        auto it = std::find(entries.begin(), entries.end(), from);
+        if (it == entries.end())
+            entries.push_back(to);
+        else
+            *it = to;
+
+        return save(entries);
+    }
+}
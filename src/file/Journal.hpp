@@ -0,0 +1,82 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\Journal.hpp
+// PURPOSE: Header file for 'src\file\Journal.cpp'. Small line-based journals shared by esh instances.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include "../platform/FileSystem.hpp"
+
+namespace FileIO
+{
+    /**
+     * @class Journal
+     * @brief A list of lines under Platform::getBasePath() that survives crashes.
+     *
+     * The file is always replaced whole: written to a temp file, flushed and
+     * renamed over the old one, so a reader sees either version and never
+     * half of one. Updates from all esh instances are serialized by a named
+     * mutex; hold a Journal::Lock around load-modify-save sequences.
+     */
+    class Journal
+    {
+    public:
+        /**
+         * @param name File name; also names the mutex.
+         */
+        explicit Journal(const std::wstring &name);
+        ~Journal();
+
+        Journal(const Journal &) = delete;
+        Journal &operator=(const Journal &) = delete;
+
+        /**
+         * @brief Owns the journal's mutex while in scope.
+         */
+        class Lock : public Platform::MutexLock
+        {
+        public:
+            explicit Lock(const Journal &journal) : Platform::MutexLock(journal.m_mutex) {}
+        };
+
+        /// @return Every complete line; none if the journal does not exist.
+        std::vector<std::wstring> load() const;
+
+        /// @brief Replaces the journal; an empty list deletes it.
+        bool save(const std::vector<std::wstring> &entries) const;
+
+        /// @brief Appends a line and flushes it to disk before returning.
+        bool add(const std::wstring &entry) const;
+
+        /// @brief Removes the first line equal to `entry`.
+        void remove(const std::wstring &entry) const;
+
+        /// @brief Swaps the first line equal to `from` for `to`.
+        bool replace(const std::wstring &from, const std::wstring &to) const;
+
+    private:
+        std::wstring m_path;
+        HANDLE m_mutex = nullptr;
+    };
+}
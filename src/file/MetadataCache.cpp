@@ -0,0 +1,452 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\MetadataCache.cpp
+// PURPOSE: Caches directory listings and file attributes, invalidated by change notifications.
+
+// INCLUDE LIBRARIES
+
+#include <iterator>
+
+#include <windows.h>
+
+#include "../platform/FileSystem.hpp"
+#include "MetadataCache.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Changes that make a cached directory stale.
+static constexpr DWORD WATCH_FILTER =
+    FILE_NOTIFY_CHANGE_FILE_NAME |
+    FILE_NOTIFY_CHANGE_DIR_NAME |
+    FILE_NOTIFY_CHANGE_ATTRIBUTES |
+    FILE_NOTIFY_CHANGE_SIZE |
+    FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+/// @brief Cache key of a path or name: Windows names compare case-insensitively.
+static std::wstring toKey(const std::wstring &text)
+{
+    std::wstring key = text;
+    if (!key.empty())
+        CharLowerBuffW(key.data(), static_cast<DWORD>(key.size()));
+    return key;
+}
+
+/// @brief Approximate memory used by one cached entry.
+static std::size_t entryBytes(const FileIO::MetadataCache::Entry &entry)
+{
+    return sizeof(entry) + entry.name.capacity() * sizeof(wchar_t);
+}
+
+/// @brief Reads one path from the file system.
+/// @return false if it does not exist or cannot be read.
+static bool readEntry(const std::wstring &full, FileIO::MetadataCache::Entry &entry)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(full.c_str(), GetFileExInfoStandard, &data))
+        return false;
+
+    size_t pos = full.find_last_of(L"\\/");
+    entry.name = (pos == std::wstring::npos) ? full : full.substr(pos + 1);
+    entry.attributes = data.dwFileAttributes;
+    entry.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    entry.lastWrite = data.ftLastWriteTime;
+    return true;
+}
+
+/// @brief Reads every entry of a directory.
+/// @return The listing, or nullptr if the directory cannot be read.
+static FileIO::MetadataCache::Listing readDirectory(const std::wstring &path)
+{
+    WIN32_FIND_DATAW ffd;
+    std::wstring search = path + L"\\*";
+
+    HANDLE hFind = FindFirstFileExW(search.c_str(), FindExInfoBasic, &ffd, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    auto entries = std::make_shared<std::vector<FileIO::MetadataCache::Entry>>();
+
+    do
+    {
+        if (wcscmp(ffd.cFileName, L".") == 0 ||
+            wcscmp(ffd.cFileName, L"..") == 0)
+            continue;
+
+        FileIO::MetadataCache::Entry entry;
+        entry.name = ffd.cFileName;
+        entry.attributes = ffd.dwFileAttributes;
+        entry.size = (static_cast<uint64_t>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow;
+        entry.lastWrite = ffd.ftLastWriteTime;
+        entries->push_back(std::move(entry));
+
+    } while (FindNextFileW(hFind, &ffd));
+
+    FindClose(hFind);
+    return entries;
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    /**
+     * @brief Returns the process-wide metadata cache.
+     */
+    MetadataCache &MetadataCache::instance()
+    {
+        static MetadataCache cache(DEFAULT_BUDGET);
+        return cache;
+    }
+
+    MetadataCache::~MetadataCache()
+    {
+        if (m_timer)
+            DeleteTimerQueueTimer(nullptr, m_timer, INVALID_HANDLE_VALUE); // waits for a running callback
+
+        for (auto &dir : m_directories)
+            FindCloseChangeNotification(dir.watch);
+    }
+
+    /**
+     * @brief Returns every entry of a directory, reading it only if it changed.
+     *
+     * @param dir Directory path.
+     * @return The listing, or nullptr if the directory cannot be read.
+     */
+    MetadataCache::Listing MetadataCache::list(const std::wstring &dir)
+    {
+        const std::wstring path = Platform::fullPath(dir);
+        const std::wstring key = toKey(path);
+
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            Directory *cached = acquire(key, path);
+            if (cached && cached->listing)
+            {
+                ++m_hits;
+                return cached->listing;
+            }
+
+            ++m_misses;
+            generation = cached ? cached->generation : 0;
+        }
+
+        // Read without the lock; the watch already exists, so a change made meanwhile is not missed
+        Listing listing = readDirectory(path);
+        if (!listing)
+            return nullptr;
+
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        Directory *cached = find(key);
+        if (cached && cached->generation == generation && !cached->listing)
+        {
+            std::size_t bytes = cached->bytes;
+            for (const auto &entry : *listing)
+                bytes += entryBytes(entry);
+
+            if (bytes <= m_budget) // a directory bigger than the whole budget is not kept
+            {
+                cached->listing = listing;
+                account(*cached, bytes);
+                evict();
+            }
+        }
+
+        return listing;
+    }
+
+    /**
+     * @brief Looks up one path, from its directory's listing if that is cached.
+     *
+     * @param path  Path to look up.
+     * @param entry Receives name, attributes, size and write time.
+     * @return false if the path does not exist or cannot be read.
+     */
+    bool MetadataCache::stat(const std::wstring &path, Entry &entry)
+    {
+        const std::wstring full = Platform::fullPath(path);
+
+        size_t pos = full.find_last_of(L"\\/");
+        if (pos == std::wstring::npos || pos + 1 == full.size())
+            return readEntry(full, entry); // a volume root has no directory to cache it in
+
+        std::wstring parent = full.substr(0, pos);
+        if (!parent.empty() && parent.back() == L':')
+            parent += L'\\';
+
+        const std::wstring name = full.substr(pos + 1);
+        const std::wstring parentKey = toKey(parent);
+        const std::wstring nameKey = toKey(name);
+
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            Directory *cached = acquire(parentKey, parent);
+            if (!cached)
+            {
+                ++m_misses;
+                return readEntry(full, entry);
+            }
+
+            if (cached->listing)
+            {
+                ++m_hits;
+
+                for (const auto &candidate : *cached->listing)
+                {
+                    if (CompareStringOrdinal(candidate.name.c_str(), -1, name.c_str(), -1, TRUE) == CSTR_EQUAL)
+                    {
+                        entry = candidate;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            auto it = cached->lookups.find(nameKey);
+            if (it != cached->lookups.end())
+            {
+                ++m_hits;
+
+                if (!it->second)
+                    return false;
+
+                entry = *it->second;
+                return true;
+            }
+
+            ++m_misses;
+            generation = cached->generation;
+        }
+
+        std::optional<Entry> found;
+        if (readEntry(full, entry))
+            found = entry;
+        else if (GetLastError() != ERROR_FILE_NOT_FOUND && GetLastError() != ERROR_PATH_NOT_FOUND)
+            return false; // e.g. access denied: may change without a notification, so not cached
+
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        Directory *cached = find(parentKey);
+        if (cached && cached->generation == generation)
+        {
+            std::size_t bytes = cached->bytes + nameKey.capacity() * sizeof(wchar_t) + (found ? entryBytes(*found) : sizeof(Entry));
+
+            cached->lookups[nameKey] = found;
+            account(*cached, bytes);
+            evict();
+        }
+
+        return found.has_value();
+    }
+
+    /**
+     * @brief Like GetFileAttributesW, served from the cache.
+     */
+    DWORD MetadataCache::attributes(const std::wstring &path)
+    {
+        Entry entry;
+        return stat(path, entry) ? entry.attributes : INVALID_FILE_ATTRIBUTES;
+    }
+
+    /**
+     * @brief Drops what is cached about a path (if it is a directory), its parent and its subdirectories.
+     */
+    void MetadataCache::invalidate(const std::wstring &path)
+    {
+        const std::wstring full = Platform::fullPath(path);
+
+        std::wstring parent;
+        size_t pos = full.find_last_of(L"\\/");
+        if (pos != std::wstring::npos && pos + 1 < full.size())
+        {
+            parent = full.substr(0, pos);
+            if (!parent.empty() && parent.back() == L':')
+                parent += L'\\';
+        }
+
+        const std::wstring key = toKey(full);
+        const std::wstring below = (key.back() == L'\\') ? key : key + L'\\';
+
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        for (auto it = m_directories.begin(); it != m_directories.end();)
+        {
+            auto current = it++;
+            if (current->key.compare(0, below.size(), below) == 0 && current->key.size() > below.size())
+                drop(current); // closes the watch that would pin the subtree
+        }
+
+        for (const std::wstring &dir : {key, toKey(parent)})
+        {
+            auto it = m_index.find(dir);
+            if (it != m_index.end())
+                drop(it->second);
+        }
+    }
+
+    /**
+     * @brief Drops every cached directory. Counters are kept.
+     */
+    void MetadataCache::clear()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        while (!m_directories.empty())
+            drop(m_directories.begin());
+    }
+
+    /**
+     * @brief Returns the counters and current memory use.
+     */
+    MetadataCache::Stats MetadataCache::stats() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return {m_hits, m_misses, m_invalidations, m_evictions, m_expirations, m_directories.size(), m_bytes, m_budget};
+    }
+
+    /**
+     * @brief Finds or creates a directory's record and makes sure it is current.
+     *
+     * A new record gets its change notification before anything is read.
+     * An existing one whose notification fired is emptied and re-armed.
+     * Called with the lock held.
+     *
+     * @return The record, or nullptr if the directory cannot be watched (then nothing is cached).
+     */
+    MetadataCache::Directory *MetadataCache::acquire(const std::wstring &key, const std::wstring &path)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            Directory &dir = *it->second;
+            m_directories.splice(m_directories.begin(), m_directories, it->second); // iterators stay valid
+            dir.lastUsed = GetTickCount64();
+
+            if (WaitForSingleObject(dir.watch, 0) == WAIT_OBJECT_0)
+            {
+                // Something changed: re-arm first so a change made while re-reading is seen next time
+                ++m_invalidations;
+                FindNextChangeNotification(dir.watch);
+
+                dir.listing.reset();
+                dir.lookups.clear();
+                dir.generation = ++m_generation;
+                account(dir, sizeof(Directory) + dir.key.capacity() * sizeof(wchar_t));
+            }
+
+            return &dir;
+        }
+
+        HANDLE watch = FindFirstChangeNotificationW(path.c_str(), FALSE, WATCH_FILTER);
+        if (watch == INVALID_HANDLE_VALUE)
+            return nullptr; // missing, or a file system without notifications
+
+        m_directories.emplace_front();
+
+        Directory &dir = m_directories.front();
+        dir.key = key;
+        dir.watch = watch;
+        dir.generation = ++m_generation;
+        dir.lastUsed = GetTickCount64();
+
+        m_index.emplace(dir.key, m_directories.begin());
+        account(dir, sizeof(Directory) + dir.key.capacity() * sizeof(wchar_t));
+
+        if (!m_timer)
+            CreateTimerQueueTimer(&m_timer, nullptr, onExpireTimer, this, WATCH_TTL, WATCH_TTL, WT_EXECUTEDEFAULT);
+
+        evict();
+        return &dir;
+    }
+
+    /**
+     * @brief Returns a directory's record without checking or touching it. Lock held.
+     */
+    MetadataCache::Directory *MetadataCache::find(const std::wstring &key)
+    {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? nullptr : &*it->second;
+    }
+
+    /**
+     * @brief Closes a directory's notification and forgets it. Lock held.
+     */
+    void MetadataCache::drop(DirectoryList::iterator it)
+    {
+        FindCloseChangeNotification(it->watch);
+
+        m_bytes -= it->bytes;
+        m_index.erase(it->key);
+        m_directories.erase(it);
+    }
+
+    /**
+     * @brief Evicts least recently used directories until within budget. Lock held.
+     *
+     * The most recently used directory is always kept.
+     */
+    void MetadataCache::evict()
+    {
+        while ((m_bytes > m_budget || m_directories.size() > MAX_DIRECTORIES) && m_directories.size() > 1)
+        {
+            drop(std::prev(m_directories.end()));
+            ++m_evictions;
+        }
+    }
+
+    /**
+     * @brief Drops directories unused for WATCH_TTL, closing their watches. Lock held.
+     *
+     * The list is ordered by use, so they are all at its back.
+     */
+    void MetadataCache::expire()
+    {
+        const ULONGLONG now = GetTickCount64();
+
+        while (!m_directories.empty() && now - m_directories.back().lastUsed >= WATCH_TTL)
+        {
+            drop(std::prev(m_directories.end()));
+            ++m_expirations;
+        }
+    }
+
+    /**
+     * @brief Timer callback: runs expire() on a thread-pool thread.
+     */
+    VOID CALLBACK MetadataCache::onExpireTimer(PVOID param, BOOLEAN /*timedOut*/)
+    {
+        auto *cache = static_cast<MetadataCache *>(param);
+
+        std::lock_guard<std::mutex> guard(cache->m_lock);
+        cache->expire();
+    }
+
+    /**
+     * @brief Sets a directory's memory use and updates the total. Lock held.
+     */
+    void MetadataCache::account(Directory &dir, std::size_t bytes)
+    {
+        m_bytes = m_bytes - dir.bytes + bytes;
+        dir.bytes = bytes;
+    }
+}
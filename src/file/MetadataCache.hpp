@@ -0,0 +1,163 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\MetadataCache.hpp
+// PURPOSE: Header file for 'src\file\MetadataCache.cpp'. Caches directory listings and file attributes.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <windows.h>
+
+#include "TreeWalker.hpp"
+
+namespace FileIO
+{
+    /**
+     * @class MetadataCache
+     * @brief Process-wide cache of directory listings and file attributes.
+     *
+     * Everything is cached per directory: its listing and the attributes of
+     * names looked up in it (including names that do not exist). Each cached
+     * directory holds a change notification handle, created before the
+     * directory is read. A lookup first polls that handle; if anything in
+     * the directory changed since, the directory's data is dropped and read
+     * again. Directories are evicted least recently used first once the
+     * memory budget or the handle limit is exceeded, and any directory
+     * unused for WATCH_TTL is dropped by a timer: an open notification
+     * handle keeps other programs from renaming the directory's parents
+     * and leaves its deletion pending, so a listed directory must not stay
+     * pinned while the shell sits at the prompt. Thread-safe.
+     */
+    class MetadataCache
+    {
+    public:
+        using Entry = TreeWalker::Entry;
+        using Listing = std::shared_ptr<const std::vector<Entry>>;
+
+        static constexpr std::size_t DEFAULT_BUDGET = 32 * 1024 * 1024; ///< Bytes
+        static constexpr std::size_t MAX_DIRECTORIES = 512;             ///< One notification handle each
+        static constexpr DWORD WATCH_TTL = 5000;                         ///< Milliseconds a directory stays cached unused
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t invalidations = 0; ///< Directories found changed on lookup
+            uint64_t evictions = 0;
+            uint64_t expirations = 0;   ///< Directories dropped after WATCH_TTL unused
+            std::size_t directories = 0;
+            std::size_t bytes = 0;
+            std::size_t budget = 0;
+        };
+
+        static MetadataCache &instance();
+
+        /**
+         * @brief Returns every entry of a directory, hidden ones included.
+         *
+         * @param dir Directory path.
+         * @return The listing, or nullptr if the directory cannot be read.
+         */
+        Listing list(const std::wstring &dir);
+
+        /**
+         * @brief Looks up one file or directory.
+         *
+         * @param path  Path to look up.
+         * @param entry Receives name, attributes, size and write time.
+         * @return false if the path does not exist or cannot be read.
+         */
+        bool stat(const std::wstring &path, Entry &entry);
+
+        /**
+         * @brief Like GetFileAttributesW, served from the cache.
+         *
+         * @return INVALID_FILE_ATTRIBUTES if the path does not exist.
+         */
+        DWORD attributes(const std::wstring &path);
+
+        /**
+         * @brief Drops what is cached about a path, its parent directory and everything below it.
+         *
+         * Called after esh changes the file system itself, so the next
+         * lookup does not depend on how fast the change notification is
+         * delivered (network shares report changes asynchronously). Also
+         * called before a tree is removed or moved: dropping a directory
+         * closes its change notification, whose open handle would
+         * otherwise keep the tree from being renamed or deleted.
+         */
+        void invalidate(const std::wstring &path);
+
+        void clear();
+
+        Stats stats() const;
+
+    private:
+        explicit MetadataCache(std::size_t budget) : m_budget(budget) {}
+        ~MetadataCache();
+
+        struct Directory
+        {
+            std::wstring key; ///< Full path, lowercase
+            HANDLE watch = INVALID_HANDLE_VALUE;
+            Listing listing;
+            std::unordered_map<std::wstring, std::optional<Entry>> lookups; ///< Keyed by lowercase name
+            std::size_t bytes = 0;
+            uint64_t generation = 0; ///< Changes whenever the data is dropped; reads started before are not stored
+            ULONGLONG lastUsed = 0;  ///< GetTickCount64() of the last lookup
+        };
+
+        using DirectoryList = std::list<Directory>;
+
+        Directory *acquire(const std::wstring &key, const std::wstring &path);
+        Directory *find(const std::wstring &key);
+        void drop(DirectoryList::iterator it);
+        void evict();
+        void expire();
+        static VOID CALLBACK onExpireTimer(PVOID param, BOOLEAN timedOut);
+        void account(Directory &dir, std::size_t bytes);
+
+        mutable std::mutex m_lock;
+
+        DirectoryList m_directories; ///< Front is most recently used
+        std::unordered_map<std::wstring_view, DirectoryList::iterator> m_index; ///< Keys view into m_directories
+
+        std::size_t m_budget;
+        std::size_t m_bytes = 0;
+        uint64_t m_generation = 0;
+
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_invalidations = 0;
+        uint64_t m_evictions = 0;
+        uint64_t m_expirations = 0;
+
+        HANDLE m_timer = nullptr; ///< Runs expire(); created with the first directory
+    };
+}
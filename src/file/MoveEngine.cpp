@@ -0,0 +1,328 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\MoveEngine.cpp
+// PURPOSE: Moves across volumes for 'mv', resumable after a crash.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+#include <windows.h>
+
+#include "../platform/FileSystem.hpp"
+#include "DeleteEngine.hpp"
+#include "MoveEngine.hpp"
+#include "Purger.hpp"
+
+// HELPER FUNCTIONS
+
+static const wchar_t *STATE_COPYING = L"copying";
+static const wchar_t *STATE_DELETING = L"deleting";
+
+/// @return When a process was started (FILETIME); 0 if unknown.
+static uint64_t processStart(HANDLE process)
+{
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(process, &creation, &exit, &kernel, &user))
+        return 0;
+
+    return (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+}
+
+/// @return Whether the process that wrote a journal entry is still running.
+static bool ownerAlive(DWORD pid, uint64_t start)
+{
+    if (pid == 0)
+        return false;
+
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!process)
+        return GetLastError() == ERROR_ACCESS_DENIED; // exists, but not ours to inspect: leave its moves alone
+
+    DWORD code = 0;
+    const bool alive = GetExitCodeProcess(process, &code) && code == STILL_ACTIVE && processStart(process) == start;
+
+    CloseHandle(process);
+    return alive;
+}
+
+/// @brief Moves this process is working on right now, by journal entry.
+static std::mutex g_activeLock;
+static std::vector<std::wstring> g_active;
+
+/**
+ * @brief Marks a journal entry as being worked on by this process while in scope.
+ */
+class ActiveMove
+{
+public:
+    explicit ActiveMove(std::wstring key) : m_key(std::move(key))
+    {
+        std::lock_guard<std::mutex> guard(g_activeLock);
+        g_active.push_back(m_key);
+    }
+
+    ~ActiveMove()
+    {
+        std::lock_guard<std::mutex> guard(g_activeLock);
+        g_active.erase(std::find(g_active.begin(), g_active.end(), m_key));
+    }
+
+    ActiveMove(const ActiveMove &) = delete;
+    ActiveMove &operator=(const ActiveMove &) = delete;
+
+    static bool contains(const std::wstring &key)
+    {
+        std::lock_guard<std::mutex> guard(g_activeLock);
+        return std::find(g_active.begin(), g_active.end(), key) != g_active.end();
+    }
+
+private:
+    std::wstring m_key;
+};
+
+/// @return The key of a move in g_active: source and destination.
+static std::wstring activeKey(const FileIO::MoveEngine::Pending &move)
+{
+    return move.src + L"\t" + move.dst;
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    /// @brief Never destroyed: it outlives every command.
+    Journal &MoveEngine::journal()
+    {
+        static Journal *journal = new Journal(L"move.journal");
+        return *journal;
+    }
+
+    BoolResult MoveEngine::move(const std::wstring &src, const std::wstring &dst, const CopyEngine::ProgressCallback &report)
+    {
+        if (MoveFileExW(src.c_str(), dst.c_str(), MOVEFILE_REPLACE_EXISTING))
+            return {true, {}};
+
+        if (GetLastError() != ERROR_NOT_SAME_DEVICE)
+            return {false, makeLastError(L"mv")};
+
+        // A copy into an existing tree could not be rolled back without deleting what was there
+        const DWORD target = GetFileAttributesW(dst.c_str());
+        if (target != INVALID_FILE_ATTRIBUTES && (target & FILE_ATTRIBUTE_DIRECTORY))
+            return {false, {ERROR_ALREADY_EXISTS, L"mv: '" + dst + L"' already exists"}};
+
+        // 'mv dir\ other\' names the same trees as 'mv dir other'; the journal records one spelling.
+        // Entries written before the separators were trimmed still resume: they are replayed as read.
+        Pending move{Platform::fullPath(src), Platform::fullPath(dst), false, GetCurrentProcessId(), processStart(GetCurrentProcess())};
+        journal().add(entry(move)); // without a journal the move still works, it just cannot be resumed
+
+        return transfer(move, report);
+    }
+
+    std::vector<MoveEngine::Pending> MoveEngine::pending()
+    {
+        std::vector<Pending> moves;
+
+        const DWORD self = GetCurrentProcessId();
+
+        for (const auto &line : journal().load())
+        {
+            std::vector<std::wstring> fields;
+            for (size_t start = 0;;)
+            {
+                const size_t tab = line.find(L'\t', start);
+                fields.push_back(line.substr(start, tab == std::wstring::npos ? tab : tab - start));
+                if (tab == std::wstring::npos)
+                    break;
+                start = tab + 1;
+            }
+
+            if (fields.size() != 3 && fields.size() != 5)
+                continue;
+
+            Pending move;
+            move.copied = fields[0] == STATE_DELETING;
+            move.src = fields[fields.size() - 2];
+            move.dst = fields.back();
+
+            if (fields.size() == 5)
+            {
+                move.owner = static_cast<DWORD>(wcstoul(fields[1].c_str(), nullptr, 10));
+                move.ownerStart = wcstoull(fields[2].c_str(), nullptr, 10);
+            }
+
+            // Still being copied by a running esh; one of ours is pending only once it stopped
+            if (ownerAlive(move.owner, move.ownerStart) && (move.owner != self || ActiveMove::contains(activeKey(move))))
+                continue;
+
+            moves.push_back(std::move(move));
+        }
+
+        return moves;
+    }
+
+    BoolResult MoveEngine::resume(const Pending &move, const CopyEngine::ProgressCallback &report)
+    {
+        return transfer(move, report);
+    }
+
+    BoolResult MoveEngine::rollback(const Pending &pending)
+    {
+        if (pending.copied)
+            return {false, {0, L"mv: '" + pending.src + L"' was already copied and is partly deleted; use 'mv --resume'"}};
+
+        Pending move = pending;
+        auto claimed = claim(move);
+        if (!claimed.ok())
+            return claimed;
+
+        ActiveMove active(activeKey(move));
+
+        if (GetFileAttributesW(move.dst.c_str()) != INVALID_FILE_ATTRIBUTES)
+        {
+            DeleteEngine engine;
+            auto res = engine.deleteTree(move.dst);
+            if (!res.ok())
+                return res;
+        }
+
+        journal().remove(entry(move));
+        return {true, {}};
+    }
+
+    /**
+     * @brief Copies the source if that is not done yet, then deletes it.
+     *
+     * Whatever fails leaves the journal entry in place for resume or rollback.
+     */
+    BoolResult MoveEngine::transfer(Pending move, const CopyEngine::ProgressCallback &report)
+    {
+        auto claimed = claim(move);
+        if (!claimed.ok())
+            return claimed;
+
+        ActiveMove active(activeKey(move));
+
+        const DWORD attributes = GetFileAttributesW(move.src.c_str());
+        const bool directory = attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+
+        std::wstring current = entry(move);
+
+        if (!move.copied)
+        {
+            if (attributes == INVALID_FILE_ATTRIBUTES)
+                return {false, makeLastError(L"mv: " + move.src)};
+
+            BoolResult res;
+
+            if (directory)
+            {
+                CopyEngine engine(0, true);
+                res = engine.copyTree(move.src, move.dst, report);
+            }
+            else
+            {
+                WIN32_FILE_ATTRIBUTE_DATA data{};
+                GetFileAttributesExW(move.src.c_str(), GetFileExInfoStandard, &data);
+
+                res = CopyEngine::copyFile(move.src, move.dst, report);
+                if (res.ok())
+                    res = CopyEngine::verifyFile(move.dst, (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow, true);
+            }
+
+            if (!res.ok())
+            {
+                res.error.message += L"\nmv: stopped; 'mv --resume' continues it, 'mv --rollback' removes the partial copy";
+                return res;
+            }
+
+            Pending copied = move;
+            copied.copied = true;
+
+            const std::wstring next = entry(copied);
+            journal().replace(current, next);
+            current = next;
+        }
+
+        // The copy is on disk: only now may the source go
+        if (attributes != INVALID_FILE_ATTRIBUTES)
+        {
+            BoolResult res;
+
+            if (directory && !(attributes & FILE_ATTRIBUTE_REPARSE_POINT))
+            {
+                res = Purger::instance().remove(move.src);
+            }
+            else
+            {
+                DeleteEngine engine;
+                res = engine.deleteTree(move.src);
+            }
+
+            if (!res.ok())
+                return res;
+        }
+
+        journal().remove(current);
+        return {true, {}};
+    }
+
+    /**
+     * @brief Makes this process the owner of a journal entry.
+     *
+     * Fails if the entry is gone or changed: another esh took it over first.
+     */
+    BoolResult MoveEngine::claim(Pending &move)
+    {
+        const DWORD self = GetCurrentProcessId();
+        const uint64_t start = processStart(GetCurrentProcess());
+
+        if (move.owner == self && move.ownerStart == start)
+            return {true, {}};
+
+        Pending owned = move;
+        owned.owner = self;
+        owned.ownerStart = start;
+
+        const Journal &moves = journal();
+        Journal::Lock lock(moves);
+
+        auto entries = moves.load();
+        auto it = std::find(entries.begin(), entries.end(), entry(move));
+        if (it == entries.end())
+            return {false, {0, L"mv: '" + move.src + L"' is being finished by another esh"}};
+
+        *it = entry(owned);
+        moves.save(entries);
+
+        move = owned;
+        return {true, {}};
+    }
+
+    /// @return The journal line for a move: state, owner id and start time, source and destination, separated by tabs.
+    std::wstring MoveEngine::entry(const Pending &move)
+    {
+        if (move.owner == 0) // as written by older versions, until claimed
+            return std::wstring(move.copied ? STATE_DELETING : STATE_COPYING) + L"\t" + move.src + L"\t" + move.dst;
+
+        return std::wstring(move.copied ? STATE_DELETING : STATE_COPYING) + L"\t" +
+               std::to_wstring(move.owner) + L"\t" + std::to_wstring(move.ownerStart) + L"\t" +
+               move.src + L"\t" + move.dst;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\MoveEngine.hpp
+// PURPOSE: Header file for 'src\file\MoveEngine.cpp'. Moves across volumes for 'mv', resumable after a crash.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../headers/Result.hpp"
+#include "CopyEngine.hpp"
+#include "Journal.hpp"
+
+namespace FileIO
+{
+    /**
+     * @class MoveEngine
+     * @brief Moves files and trees, copying them when they change volume.
+     *
+     * A move is a rename first. Only when the destination is on another
+     * volume is the source copied with a durable CopyEngine (flushed and
+     * size-checked), and deleted once the copy is complete.
+     *
+     * Each copy is recorded in 'move.journal' under Platform::getBasePath()
+     * before it starts and marked when the copy is complete. A move
+     * interrupted while copying can be resumed (files already copied are
+     * kept) or rolled back (the partial copy is deleted); one interrupted
+     * while deleting the source can only be resumed.
+     *
+     * The journal is shared by all esh instances, so each entry names the
+     * process working on it (id and start time, which together survive id
+     * reuse). A move whose owner is still running is not pending; resuming
+     * or rolling one back first takes it over.
+     */
+    class MoveEngine
+    {
+    public:
+        /**
+         * @brief A move in the journal.
+         */
+        struct Pending
+        {
+            std::wstring src; ///< Absolute, without a trailing separator (see Platform::fullPath)
+            std::wstring dst; ///< Same form as src
+            bool copied = false; ///< The copy is complete; the source is being deleted
+            DWORD owner = 0;           ///< Process working on it; 0 in journals of older versions
+            uint64_t ownerStart = 0;   ///< Its creation time (FILETIME)
+        };
+
+        /**
+         * @brief Moves a file or directory tree.
+         *
+         * @param src    Source path.
+         * @param dst    Destination path, including the final name.
+         * @param report Progress of a copy between volumes.
+         */
+        static BoolResult move(const std::wstring &src, const std::wstring &dst, const CopyEngine::ProgressCallback &report = {});
+
+        /// @return The moves the journal lists whose owner is gone, oldest first.
+        static std::vector<Pending> pending();
+
+        /**
+         * @brief Finishes an interrupted move.
+         */
+        static BoolResult resume(const Pending &move, const CopyEngine::ProgressCallback &report = {});
+
+        /**
+         * @brief Undoes a move interrupted while copying: deletes the partial copy.
+         */
+        static BoolResult rollback(const Pending &move);
+
+    private:
+        static BoolResult transfer(Pending move, const CopyEngine::ProgressCallback &report);
+        static BoolResult claim(Pending &move);
+        static std::wstring entry(const Pending &move);
+        static Journal &journal();
+    };
+}
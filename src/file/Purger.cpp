@@ -0,0 +1,214 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\Purger.cpp
+// PURPOSE: Moves trees out of the way and deletes them in the background.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <windows.h>
+
+#include "../platform/FileSystem.hpp"
+#include "DeleteEngine.hpp"
+#include "Purger.hpp"
+
+// HELPER FUNCTIONS
+
+static const wchar_t *TRASH_DIRECTORY = L".esh-trash";
+static const wchar_t *SIBLING_PREFIX = L".esh-deleting-";
+
+/// @return A name no other rm in any esh instance will pick.
+static std::wstring uniqueName()
+{
+    static std::atomic<uint32_t> counter{0};
+
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+
+    wchar_t name[64];
+    swprintf(name, 64, L"%08lx%08lx-%lu-%u", now.dwHighDateTime, now.dwLowDateTime,
+             GetCurrentProcessId(), counter.fetch_add(1));
+    return name;
+}
+
+/// @brief Only paths esh itself moved away may ever be purged from the journal.
+static bool isTrashPath(const std::wstring &path)
+{
+    const size_t slash = path.find_last_of(L'\\');
+    if (slash == std::wstring::npos || slash == 0)
+        return false;
+
+    const std::wstring name = path.substr(slash + 1);
+    if (name.rfind(SIBLING_PREFIX, 0) == 0)
+        return true;
+
+    const size_t parent = path.find_last_of(L'\\', slash - 1);
+    return parent != std::wstring::npos && path.compare(parent + 1, slash - parent - 1, TRASH_DIRECTORY) == 0;
+}
+
+static bool exists(const std::wstring &path)
+{
+    return GetFileAttributesW(path.c_str()) != INVALID_FILE_ATTRIBUTES;
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    /// @brief Never destroyed: the purge thread may still be running when esh exits.
+    Purger &Purger::instance()
+    {
+        static Purger *purger = new Purger;
+        return *purger;
+    }
+
+    BoolResult Purger::remove(const std::wstring &path)
+    {
+        const std::wstring source = Platform::fullPath(path);
+
+        for (const auto &trash : candidates(source))
+        {
+            // Journal first: a crash right after the rename must not lose the tree
+            if (!m_journal.add(trash))
+                break;
+
+            if (MoveFileExW(source.c_str(), trash.c_str(), 0))
+            {
+                enqueue(trash);
+                return {true, {}};
+            }
+
+            m_journal.remove(trash);
+        }
+
+        // Could not move it away: delete it here, the name has to be gone when rm returns
+        DeleteEngine engine;
+        return engine.deleteTree(source);
+    }
+
+    void Purger::resume()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_resumed)
+                return;
+            m_resumed = true;
+        }
+
+        std::vector<std::wstring> entries;
+        {
+            Journal::Lock lock(m_journal);
+
+            entries = m_journal.load();
+
+            // Renames that never happened, or trees another instance finished
+            auto gone = std::remove_if(entries.begin(), entries.end(), [](const std::wstring &entry)
+                                       { return !isTrashPath(entry) || !exists(entry); });
+
+            if (gone != entries.end())
+            {
+                entries.erase(gone, entries.end());
+                m_journal.save(entries);
+            }
+        }
+
+        for (const auto &entry : entries)
+            enqueue(entry);
+    }
+
+    void Purger::drain()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_idle.wait(guard, [this]()
+                    { return !m_running; });
+    }
+
+    void Purger::enqueue(const std::wstring &trash)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_pending.push_back(trash);
+
+        if (!m_running)
+        {
+            m_running = true;
+            std::thread([this]()
+                        { run(); })
+                .detach();
+        }
+    }
+
+    /// @brief Purges queued trees one at a time; each is already spread over a pool of threads.
+    void Purger::run()
+    {
+        while (true)
+        {
+            std::wstring trash;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_pending.empty())
+                {
+                    m_running = false;
+                    m_idle.notify_all();
+                    return;
+                }
+
+                trash = std::move(m_pending.front());
+                m_pending.pop_front();
+            }
+
+            DeleteEngine engine;
+            engine.deleteTree(trash, true);
+
+            // Whatever could not be deleted stays listed and is retried on the next start
+            if (!exists(trash))
+                m_journal.remove(trash);
+        }
+    }
+
+    /// @return Where the tree may be renamed to, best first. Both are on the same volume.
+    std::vector<std::wstring> Purger::candidates(const std::wstring &path)
+    {
+        std::vector<std::wstring> result;
+        const std::wstring name = uniqueName();
+
+        wchar_t root[MAX_PATH];
+        if (GetVolumePathNameW(path.c_str(), root, MAX_PATH))
+        {
+            std::wstring trashDir = root;
+            if (!trashDir.empty() && trashDir.back() != L'\\')
+                trashDir += L'\\';
+            trashDir += TRASH_DIRECTORY;
+
+            if (CreateDirectoryW(trashDir.c_str(), nullptr))
+                SetFileAttributesW(trashDir.c_str(), FILE_ATTRIBUTE_HIDDEN);
+
+            // The tree cannot be moved into itself
+            if (exists(trashDir) && path.size() > 3 && trashDir.rfind(path + L"\\", 0) != 0 && trashDir != path)
+                result.push_back(trashDir + L"\\" + name);
+        }
+
+        const size_t slash = path.find_last_of(L'\\');
+        if (slash != std::wstring::npos && slash + 1 < path.size())
+            result.push_back(path.substr(0, slash + 1) + SIBLING_PREFIX + name);
+
+        return result;
+    }
+}
@@ -0,0 +1,89 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\Purger.hpp
+// PURPOSE: Header file for 'src\file\Purger.cpp'. Moves trees out of the way and deletes them in the background.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../headers/Result.hpp"
+#include "Journal.hpp"
+
+namespace FileIO
+{
+    /**
+     * @class Purger
+     * @brief Backs 'rm -r': a tree is renamed away at once and deleted later.
+     *
+     * The tree is moved into '.esh-trash' at the root of its volume (or,
+     * failing that, to a hidden sibling), which is a single rename. A
+     * background thread then deletes it with a DeleteEngine at low priority.
+     *
+     * Every trash path is recorded in 'purge.journal' under
+     * Platform::getBasePath() before the rename and dropped once the tree is
+     * gone, so trees left behind when esh exits are purged on the next start.
+     * The journal is shared between esh instances.
+     */
+    class Purger
+    {
+    public:
+        static Purger &instance();
+
+        /**
+         * @brief Removes a directory tree from its place.
+         *
+         * If the tree cannot be renamed (e.g. a file in it is open), it is
+         * deleted in place before returning.
+         *
+         * @param path Directory to remove.
+         */
+        BoolResult remove(const std::wstring &path);
+
+        /**
+         * @brief Queues the trees the journal still lists (left by earlier sessions).
+         */
+        void resume();
+
+        /**
+         * @brief Blocks until every queued tree has been purged.
+         */
+        void drain();
+
+    private:
+        Purger() = default;
+
+        void enqueue(const std::wstring &trash);
+        void run();
+
+        std::vector<std::wstring> candidates(const std::wstring &path);
+
+        Journal m_journal{L"purge.journal"};
+
+        std::mutex m_lock; ///< Guards the members below
+        std::condition_variable m_idle;
+        std::deque<std::wstring> m_pending;
+        bool m_running = false;
+        bool m_resumed = false;
+    };
+}
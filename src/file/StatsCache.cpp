@@ -0,0 +1,193 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\StatsCache.cpp
+// PURPOSE: Remembers 'stats' counts so grown files only count their new tail.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <string>
+
+#include <windows.h>
+
+#include "../platform/AppDataPath.hpp"
+#include "../platform/FileSystem.hpp"
+#include "StatsCache.hpp"
+
+// HELPER FUNCTIONS
+
+static constexpr uint32_t CACHE_MAGIC = 0x43535345; // "ESSC"
+static constexpr uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader
+{
+    uint32_t magic = CACHE_MAGIC;
+    uint32_t version = CACHE_VERSION;
+    uint32_t count = 0;
+    uint32_t reserved = 0;
+};
+
+static std::wstring cachePath()
+{
+    return (Platform::getBasePath() / L"stats.cache").wstring();
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    Result<CountEngine::Counts> StatsCache::count(HANDLE file, const BY_HANDLE_FILE_INFORMATION &info)
+    {
+        const uint64_t size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        if (size < MIN_SIZE)
+            return CountEngine::count(file);
+
+        const uint64_t index = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        const uint64_t lastWrite = (static_cast<uint64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+
+        std::vector<Record> records = load();
+
+        auto it = std::find_if(records.begin(), records.end(), [&](const Record &r)
+                               { return r.volume == info.dwVolumeSerialNumber && r.index == index; });
+
+        const bool known = it != records.end();
+
+        Record record;
+        if (known)
+        {
+            record = *it;
+            records.erase(it);
+        }
+
+        Result<CountEngine::Counts> result;
+
+        if (known && record.size == size && record.lastWrite == lastWrite)
+        {
+            // Unchanged since the last count
+            result.value.lines = record.lines;
+            result.value.words = record.words;
+            result.value.bytes = record.size;
+            result.value.endsInWord = record.endsInWord != 0;
+        }
+        else
+        {
+            // Appended to if the bytes before the old end are still the same
+            uint64_t hash = 0;
+            const bool appended = known && record.size <= size &&
+                                  fingerprint(file, record.size, hash) && hash == record.fingerprint;
+
+            CountEngine::Counts resume;
+            resume.lines = record.lines;
+            resume.words = record.words;
+            resume.bytes = record.size;
+            resume.endsInWord = record.endsInWord != 0;
+
+            result = CountEngine::count(file, appended ? &resume : nullptr);
+            if (!result.ok())
+                return result;
+
+            if (!fingerprint(file, result.value.bytes, hash))
+                return result; // counted, but cannot be recorded
+
+            record.volume = info.dwVolumeSerialNumber;
+            record.index = index;
+            record.size = result.value.bytes;
+            record.lastWrite = lastWrite; // as of before the count: a file still growing is checked again next time
+            record.lines = result.value.lines;
+            record.words = result.value.words;
+            record.endsInWord = result.value.endsInWord ? 1 : 0;
+            record.fingerprint = hash;
+        }
+
+        records.insert(records.begin(), record); // most recently used first
+        if (records.size() > MAX_RECORDS)
+            records.resize(MAX_RECORDS);
+
+        save(records);
+        return result;
+    }
+
+    /// @return The stored records; none if the file is missing, damaged or from another version.
+    std::vector<StatsCache::Record> StatsCache::load()
+    {
+        std::vector<Record> records;
+
+        HANDLE hFile = CreateFileW(cachePath().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return records;
+
+        CacheHeader header;
+        DWORD read = 0;
+
+        if (ReadFile(hFile, &header, sizeof(header), &read, nullptr) && read == sizeof(header) &&
+            header.magic == CACHE_MAGIC && header.version == CACHE_VERSION && header.count <= MAX_RECORDS)
+        {
+            records.resize(header.count);
+
+            const DWORD bytes = static_cast<DWORD>(header.count * sizeof(Record));
+            if (!ReadFile(hFile, records.data(), bytes, &read, nullptr) || read != bytes)
+                records.clear();
+        }
+
+        CloseHandle(hFile);
+        return records;
+    }
+
+    /// @brief Writes a new cache file next to the old one and swaps it in, so readers never see half of one.
+    void StatsCache::save(const std::vector<Record> &records)
+    {
+        CacheHeader header;
+        header.count = static_cast<uint32_t>(records.size());
+
+        std::string data(reinterpret_cast<const char *>(&header), sizeof(header));
+        data.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(Record));
+
+        // Only a cache: a copy lost to a crash is rebuilt, so skip the flush
+        Platform::replaceFile(cachePath(), data, false);
+    }
+
+    /**
+     * @brief Hashes the bytes just before `end` (FNV-1a).
+     *
+     * Only these bytes are compared when a file grew; a file rewritten in
+     * place further up with its end unchanged is not noticed.
+     */
+    bool StatsCache::fingerprint(HANDLE file, uint64_t end, uint64_t &hash)
+    {
+        const DWORD length = static_cast<DWORD>(std::min<uint64_t>(end, FINGERPRINT_SIZE));
+        char buffer[FINGERPRINT_SIZE];
+
+        OVERLAPPED ov{};
+        const uint64_t offset = end - length;
+        ov.Offset = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD read = 0;
+        if (length > 0 && (!ReadFile(file, buffer, length, &read, &ov) || read != length))
+            return false;
+
+        hash = 14695981039346656037ull;
+        for (DWORD i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+
+        return true;
+    }
+}
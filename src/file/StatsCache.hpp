@@ -0,0 +1,84 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\StatsCache.hpp
+// PURPOSE: Header file for 'src\file\StatsCache.cpp'. Remembers 'stats' counts so grown files only count their new tail.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <windows.h>
+
+#include "../headers/Result.hpp"
+#include "CountEngine.hpp"
+
+namespace FileIO
+{
+    /**
+     * @brief Persistent line/word/byte counts of large files, for 'stats'.
+     *
+     * Records are keyed by file identity (volume serial number and file
+     * index), so a log keeps its record when it is renamed. Each holds the
+     * size and last write time at the time of the count, the counts, the
+     * word state at the end, and a hash of the last bytes counted.
+     *
+     * An unchanged file is answered from the record without reading it. A
+     * file that grew and still has the same bytes before the old end is
+     * taken as appended to: only the new tail is counted. Anything else is
+     * counted from the start.
+     *
+     * The records live in 'stats.cache' under Platform::getBasePath(),
+     * most recently used first, and are replaced as a whole.
+     */
+    class StatsCache
+    {
+    public:
+        static constexpr uint64_t MIN_SIZE = 1024 * 1024; ///< Smaller files are cheap to count again
+        static constexpr std::size_t MAX_RECORDS = 256;
+        static constexpr DWORD FINGERPRINT_SIZE = 4096; ///< Bytes hashed before the end of a record
+
+        /**
+         * @brief Counts a file, reusing the record of an earlier count where possible.
+         *
+         * @param file Handle opened with GENERIC_READ.
+         * @param info The file's information, taken before counting.
+         * @return The counts of the whole file.
+         */
+        static Result<CountEngine::Counts> count(HANDLE file, const BY_HANDLE_FILE_INFORMATION &info);
+
+    private:
+        struct Record
+        {
+            uint32_t volume = 0;
+            uint32_t endsInWord = 0;
+            uint64_t index = 0;
+            uint64_t size = 0;
+            uint64_t lastWrite = 0;
+            uint64_t lines = 0;
+            uint64_t words = 0;
+            uint64_t fingerprint = 0;
+        };
+
+        static std::vector<Record> load();
+        static void save(const std::vector<Record> &records);
+        static bool fingerprint(HANDLE file, uint64_t end, uint64_t &hash);
+    };
+}
@@ -0,0 +1,313 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\TailFollower.cpp
+// PURPOSE: Follows growing files for 'tail -f' and 'tail -F'.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+
+#include <windows.h>
+
+#include "../headers/Unicode.hpp"
+#include "../platform/FileSystem.hpp"
+#include "TailFollower.hpp"
+
+// HELPER FUNCTIONS
+
+static constexpr DWORD READ_SIZE = 1024 * 1024;
+
+static constexpr DWORD WATCH_FILTER =
+    FILE_NOTIFY_CHANGE_FILE_NAME |
+    FILE_NOTIFY_CHANGE_SIZE |
+    FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+/// @brief Directory a file lives in, as an absolute path.
+static std::wstring parentDirectory(const std::wstring &path)
+{
+    const std::wstring full = Platform::fullPath(path);
+
+    size_t pos = full.find_last_of(L"\\/");
+    if (pos == std::wstring::npos)
+        return L".";
+
+    std::wstring parent = full.substr(0, pos);
+    if (parent.empty() || parent.back() == L':')
+        parent += L'\\';
+
+    return parent;
+}
+
+// FUNCTIONS
+
+namespace FileIO
+{
+    TailFollower::TailFollower(bool byName, Execution::Executor::Context &ctx)
+        : m_byName(byName), m_ctx(ctx)
+    {
+    }
+
+    TailFollower::~TailFollower()
+    {
+        for (auto &target : m_targets)
+        {
+            if (target.file != INVALID_HANDLE_VALUE)
+                CloseHandle(target.file);
+        }
+    }
+
+    void TailFollower::add(const std::wstring &name, HANDLE file, uint64_t offset)
+    {
+        Identity identity;
+        if (file != INVALID_HANDLE_VALUE && !identify(file, identity))
+        {
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+
+        if (file == INVALID_HANDLE_VALUE && !m_byName)
+            return; // nothing to follow; the error was reported when opening it
+
+        m_targets.push_back(Target{name, file, offset, identity});
+        m_last = m_targets.size() - 1;
+    }
+
+    void TailFollower::run()
+    {
+        if (m_targets.empty())
+            return;
+
+        m_buffer.resize(READ_SIZE);
+
+        std::vector<HANDLE> watches = watchDirectories();
+
+        std::vector<HANDLE> handles;
+        if (m_ctx.interrupt)
+            handles.push_back(m_ctx.interrupt);
+        handles.insert(handles.end(), watches.begin(), watches.end());
+
+        DWORD timeout = MIN_POLL;
+        bool open = true;
+
+        while (open)
+        {
+            DWORD r = WAIT_TIMEOUT;
+            if (handles.empty())
+                Sleep(timeout);
+            else
+                r = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, timeout);
+
+            if (m_ctx.interrupt && r == WAIT_OBJECT_0)
+                break; // Ctrl+C
+
+            if (r == WAIT_FAILED)
+                Sleep(timeout); // keep polling rather than spinning
+
+            // Several directories may have changed; re-arm every watch that fired
+            for (HANDLE watch : watches)
+            {
+                if (WaitForSingleObject(watch, 0) == WAIT_OBJECT_0)
+                    FindNextChangeNotification(watch);
+            }
+
+            bool active = false;
+            for (std::size_t i = 0; i < m_targets.size() && open; ++i)
+            {
+                Status status = poll(i);
+                active |= status == Status::DATA;
+                open = status != Status::CLOSED;
+            }
+
+            if (open && active)
+                open = Execution::Executor::flushOutput(m_ctx); // a pipe or file must not wait for a full buffer
+
+            timeout = active ? MIN_POLL : std::min(timeout * 2, MAX_POLL);
+        }
+
+        for (HANDLE watch : watches)
+            FindCloseChangeNotification(watch);
+    }
+
+    bool TailFollower::identify(HANDLE file, Identity &identity)
+    {
+        BY_HANDLE_FILE_INFORMATION info{};
+        if (!GetFileInformationByHandle(file, &info))
+            return false;
+
+        identity.volume = info.dwVolumeSerialNumber;
+        identity.index = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        return true;
+    }
+
+    /// @brief One change notification per distinct parent directory.
+    /// @return The watches; directories that cannot be watched are only polled.
+    std::vector<HANDLE> TailFollower::watchDirectories() const
+    {
+        std::vector<std::wstring> directories;
+        std::vector<HANDLE> watches;
+
+        for (const auto &target : m_targets)
+        {
+            std::wstring dir = parentDirectory(target.name);
+
+            bool seen = std::any_of(directories.begin(), directories.end(), [&](const std::wstring &other)
+                                    { return CompareStringOrdinal(dir.c_str(), -1, other.c_str(), -1, TRUE) == CSTR_EQUAL; });
+            if (seen)
+                continue;
+
+            directories.push_back(dir);
+
+            if (watches.size() + 1 >= MAXIMUM_WAIT_OBJECTS) // one slot is the interrupt event
+                continue;
+
+            HANDLE watch = FindFirstChangeNotificationW(dir.c_str(), FALSE, WATCH_FILTER);
+            if (watch != INVALID_HANDLE_VALUE)
+                watches.push_back(watch);
+        }
+
+        return watches;
+    }
+
+    TailFollower::Status TailFollower::poll(std::size_t index)
+    {
+        if (m_byName)
+        {
+            Status status = reopen(index);
+            if (status == Status::CLOSED)
+                return status;
+        }
+
+        if (m_targets[index].file == INVALID_HANDLE_VALUE)
+            return Status::IDLE;
+
+        return copyNew(index);
+    }
+
+    /// @brief Follows the path to whatever file it names now (-F).
+    ///
+    /// The file being followed is read to its end before it is let go, so
+    /// lines written just before a rotation are not lost.
+    TailFollower::Status TailFollower::reopen(std::size_t index)
+    {
+        Target &target = m_targets[index];
+
+        HANDLE file = CreateFileW(
+            target.name.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, // the writer may rotate it while we read
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+
+        Identity identity;
+        if (file != INVALID_HANDLE_VALUE && !identify(file, identity))
+        {
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+
+        if (file != INVALID_HANDLE_VALUE && target.file != INVALID_HANDLE_VALUE && identity == target.identity)
+        {
+            CloseHandle(file); // still the same file
+            return Status::IDLE;
+        }
+
+        if (file == INVALID_HANDLE_VALUE && target.file == INVALID_HANDLE_VALUE)
+            return Status::IDLE; // still missing
+
+        Status status = Status::IDLE;
+        const bool had = target.file != INVALID_HANDLE_VALUE;
+
+        if (had)
+        {
+            status = copyNew(index);
+            CloseHandle(target.file);
+            target.file = INVALID_HANDLE_VALUE;
+        }
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            Execution::Executor::writeError(m_ctx, L"tail: '" + target.name + L"' has become inaccessible");
+            return status;
+        }
+
+        Execution::Executor::writeError(m_ctx, L"tail: '" + target.name + (had ? L"' has been replaced; following new file" : L"' has appeared; following new file"));
+
+        target.file = file;
+        target.identity = identity;
+        target.offset = 0;
+        return status;
+    }
+
+    /// @brief Prints whatever was appended since the last call.
+    TailFollower::Status TailFollower::copyNew(std::size_t index)
+    {
+        Target &target = m_targets[index];
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(target.file, &size))
+            return Status::IDLE;
+
+        const uint64_t end = static_cast<uint64_t>(size.QuadPart);
+
+        if (end < target.offset)
+        {
+            Execution::Executor::writeError(m_ctx, L"tail: " + target.name + L": file truncated");
+            target.offset = 0;
+        }
+
+        if (end == target.offset)
+            return Status::IDLE;
+
+        if (m_targets.size() > 1 && m_last != index)
+        {
+            if (!Execution::Executor::writeOutput(m_ctx, L"\n==> " + target.name + L" <==\n"))
+                return Status::CLOSED;
+            m_last = index;
+        }
+
+        const uint64_t before = target.offset;
+
+        while (target.offset < end)
+        {
+            OVERLAPPED ov{};
+            ov.Offset = static_cast<DWORD>(target.offset);
+            ov.OffsetHigh = static_cast<DWORD>(target.offset >> 32);
+
+            const DWORD length = static_cast<DWORD>(std::min<uint64_t>(end - target.offset, READ_SIZE));
+
+            DWORD read = 0;
+            if (!ReadFile(target.file, m_buffer.data(), length, &read, &ov) || read == 0)
+                break; // truncated meanwhile; the next poll notices
+
+            // A writer may be in the middle of a character: leave it for the next poll
+            DWORD usable = read;
+            if (target.offset + read == end)
+                usable = static_cast<DWORD>(unicode::utf8_complete_length(m_buffer.data(), read));
+
+            if (usable > 0 && !Execution::Executor::writeBytes(m_ctx, m_buffer.data(), usable))
+                return Status::CLOSED;
+
+            target.offset += usable;
+            if (usable < read)
+                break;
+        }
+
+        return target.offset != before ? Status::DATA : Status::IDLE;
+    }
+}
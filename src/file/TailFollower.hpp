@@ -0,0 +1,118 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\TailFollower.hpp
+// PURPOSE: Header file for 'src\file\TailFollower.cpp'. Follows growing files for 'tail -f' and 'tail -F'.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include "../execution/Execution.hpp"
+
+namespace FileIO
+{
+    /**
+     * @class TailFollower
+     * @brief Prints what is appended to a set of files until interrupted.
+     *
+     * Sleeps on a change notification for each parent directory together
+     * with the interrupt event. NTFS may report the size of a file still
+     * open for writing late, so the files are also polled, every 100 ms
+     * while data is arriving and backing off to once a second when idle.
+     * When output moves from one file to another, a '==> name <==' header
+     * is printed first (only if more than one file is followed). A
+     * character still being written at the end of a file is left for the
+     * next poll, so files never interleave in the middle of one.
+     *
+     * A file that shrinks was truncated and is read again from its start.
+     * Following by name (-F) also reopens the path on every poll: a file
+     * that was rotated, replaced or deleted is read to its end and the new
+     * one followed from its start.
+     */
+    class TailFollower
+    {
+    public:
+        static constexpr DWORD MIN_POLL = 100;  ///< Milliseconds, while data is arriving
+        static constexpr DWORD MAX_POLL = 1000; ///< Milliseconds, once idle
+
+        /// @param byName Follow the path rather than the open file (-F).
+        TailFollower(bool byName, Execution::Executor::Context &ctx);
+        ~TailFollower();
+
+        TailFollower(const TailFollower &) = delete;
+        TailFollower &operator=(const TailFollower &) = delete;
+
+        /**
+         * @brief Adds a file; the last one added is taken as the last printed.
+         *
+         * @param name   Path as given by the user.
+         * @param file   Open handle, now owned by the follower, or
+         *               INVALID_HANDLE_VALUE if the file could not be opened
+         *               (only kept when following by name).
+         * @param offset Where the output so far ended.
+         */
+        void add(const std::wstring &name, HANDLE file, uint64_t offset);
+
+        /// @brief Prints new data until Ctrl+C or until the reader goes away.
+        void run();
+
+    private:
+        struct Identity
+        {
+            DWORD volume = 0;
+            uint64_t index = 0;
+
+            bool operator==(const Identity &other) const { return volume == other.volume && index == other.index; }
+            bool operator!=(const Identity &other) const { return !(*this == other); }
+        };
+
+        struct Target
+        {
+            std::wstring name;
+            HANDLE file = INVALID_HANDLE_VALUE;
+            uint64_t offset = 0;
+            Identity identity;
+        };
+
+        enum class Status : uint8_t
+        {
+            IDLE,
+            DATA,
+            CLOSED ///< The reader has gone away
+        };
+
+        static bool identify(HANDLE file, Identity &identity);
+
+        std::vector<HANDLE> watchDirectories() const;
+        Status poll(std::size_t index);
+        Status reopen(std::size_t index);
+        Status copyNew(std::size_t index);
+
+        bool m_byName;
+        Execution::Executor::Context &m_ctx;
+
+        std::vector<Target> m_targets;
+        std::size_t m_last = 0; ///< Target whose data was printed last
+        std::vector<char> m_buffer;
+    };
+}
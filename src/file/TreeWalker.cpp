@@ -0,0 +1,240 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\TreeWalker.cpp
+// PURPOSE: Parallel directory walk with output in tree order.
+
+// INCLUDE LIBRARIES
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <windows.h>
+
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress, WakeByAddress*
+
+#include "TreeWalker.hpp"
+#include "WorkQueue.hpp"
+
+namespace FileIO
+{
+    /// @brief Listing state of a directory.
+    enum NodeState : uint32_t
+    {
+        PENDING,
+        LISTED,
+        FAILED,
+    };
+
+    /**
+     * @brief A directory in the walk.
+     *
+     * Filled by one worker, then only read by the reporting thread once
+     * `state` has left PENDING.
+     */
+    struct TreeWalker::Node
+    {
+        struct Item
+        {
+            Entry entry;
+            std::unique_ptr<Node> child; ///< Set for directories that are entered
+        };
+
+        std::wstring path;
+        std::vector<Item> items;
+        std::atomic<uint32_t> state{PENDING};
+
+        explicit Node(std::wstring p) : path(std::move(p)) {}
+    };
+
+    TreeWalker::TreeWalker(bool showHidden, unsigned workers)
+        : m_showHidden(showHidden), m_workers(workers)
+    {
+    }
+
+    void TreeWalker::list(Node &node, bool recursive) const
+    {
+        WIN32_FIND_DATAW ffd;
+        std::wstring search = node.path + L"\\*";
+
+        // Basic info skips the 8.3 names; large fetch returns more entries per call
+        HANDLE hFind = FindFirstFileExW(search.c_str(), FindExInfoBasic, &ffd, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+        if (hFind == INVALID_HANDLE_VALUE)
+        {
+            node.state.store(FAILED, std::memory_order_release);
+            return;
+        }
+
+        do
+        {
+            if (wcscmp(ffd.cFileName, L".") == 0 ||
+                wcscmp(ffd.cFileName, L"..") == 0)
+                continue;
+            if (!m_showHidden && (ffd.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN))
+                continue;
+
+            Node::Item item;
+            item.entry.name = ffd.cFileName;
+            item.entry.attributes = ffd.dwFileAttributes;
+            item.entry.size = (static_cast<uint64_t>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow;
+            item.entry.lastWrite = ffd.ftLastWriteTime;
+
+            if (recursive &&
+                (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+                !(ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                item.child = std::make_unique<Node>(node.path + L"\\" + ffd.cFileName);
+
+            node.items.push_back(std::move(item));
+
+        } while (FindNextFileW(hFind, &ffd));
+
+        FindClose(hFind);
+    }
+
+    bool TreeWalker::walk(const std::wstring &root, bool recursive, const EntryCallback &onEntry, const ErrorCallback &onError, const IdleCallback &onIdle)
+    {
+        auto rootNode = std::make_unique<Node>(root);
+
+        WorkQueue<Node *> queue(m_workers, 1);
+        std::vector<std::thread> threads;
+
+        auto run = [this, &queue](unsigned worker, Node *node)
+        {
+            if (m_stop.load(std::memory_order_relaxed))
+                return; // the walk was stopped; just drain
+
+            list(*node, true);
+
+            // First child pushed last, so this worker takes it next (tree order)
+            for (auto it = node->items.rbegin(); it != node->items.rend(); ++it)
+            {
+                if (it->child)
+                    queue.push(worker, it->child.get());
+            }
+
+            // Publish only after the children are queued: from here on the reporting thread owns the node
+            uint32_t expected = PENDING;
+            node->state.compare_exchange_strong(expected, LISTED, std::memory_order_release);
+
+            m_listed.fetch_add(1, std::memory_order_release);
+            WakeByAddressAll(&m_listed);
+        };
+
+        if (!recursive)
+        {
+            list(*rootNode, false); // one directory: no threads needed
+
+            uint32_t expected = PENDING;
+            rootNode->state.compare_exchange_strong(expected, LISTED);
+        }
+        else
+        {
+            queue.push(0, rootNode.get());
+
+            for (unsigned i = 0; i < queue.workers(); ++i)
+                threads.emplace_back([&queue, &run, i]() { queue.work(i, run); });
+        }
+
+        struct Frame
+        {
+            Node *node;
+            size_t index;
+            std::wstring prefix;
+        };
+
+        std::vector<Frame> stack{{rootNode.get(), 0, L""}};
+        bool ok = true;
+
+        while (ok && !stack.empty())
+        {
+            Node *node = stack.back().node;
+
+            // Wait until this directory is listed
+            bool idled = false;
+            for (;;)
+            {
+                uint32_t listed = m_listed.load(std::memory_order_acquire);
+
+                if (node->state.load(std::memory_order_acquire) != PENDING)
+                    break;
+
+                if (!idled)
+                {
+                    idled = true;
+                    if (onIdle && !onIdle())
+                    {
+                        ok = false;
+                        break;
+                    }
+                    continue;
+                }
+
+                WaitOnAddress(&m_listed, &listed, sizeof(listed), INFINITE);
+            }
+
+            if (!ok)
+                break;
+
+            Frame &frame = stack.back();
+
+            if (node->state.load(std::memory_order_acquire) == FAILED)
+            {
+                onError(node->path);
+
+                if (stack.size() == 1)
+                    ok = false;
+                frame.index = node->items.size();
+            }
+
+            if (frame.index == node->items.size())
+            {
+                stack.pop_back();
+
+                // Done with this subtree; free it
+                if (!stack.empty())
+                    stack.back().node->items[stack.back().index - 1].child.reset();
+                continue;
+            }
+
+            const auto &item = node->items[frame.index++];
+            const bool last = frame.index == node->items.size();
+
+            if (!onEntry(item.entry, frame.prefix, last))
+            {
+                ok = false;
+                break;
+            }
+
+            if (item.child)
+            {
+                std::wstring prefix = frame.prefix + (last ? L"    " : L"|   ");
+                stack.push_back({item.child.get(), 0, std::move(prefix)}); // `frame` is invalid from here
+            }
+        }
+
+        if (!threads.empty())
+        {
+            m_stop.store(true, std::memory_order_relaxed);
+
+            queue.wait(INFINITE);
+            for (auto &thread : threads)
+                thread.join();
+        }
+
+        return ok;
+    }
+}
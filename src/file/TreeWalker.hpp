@@ -0,0 +1,91 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\TreeWalker.hpp
+// PURPOSE: Header file for 'src\file\TreeWalker.cpp'. Parallel directory walk with output in tree order.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <windows.h>
+
+namespace FileIO
+{
+    /**
+     * @brief Lists a directory tree on several threads and reports it in tree order.
+     *
+     * Worker threads list directories (through a WorkQueue) as fast as they
+     * can. The calling thread walks the tree depth-first behind them, like a
+     * reorder buffer: an entry is reported as soon as everything before it
+     * in tree order is known, and the thread only waits when the next
+     * directory has not been listed yet. Subtrees are freed once reported.
+     */
+    class TreeWalker
+    {
+    public:
+        /**
+         * @brief One directory entry.
+         */
+        struct Entry
+        {
+            std::wstring name;
+            DWORD attributes = 0;
+            uint64_t size = 0;
+            FILETIME lastWrite{};
+        };
+
+        /// Called in tree order with the tree-drawing prefix of the entry's depth; false stops the walk
+        using EntryCallback = std::function<bool(const Entry &entry, const std::wstring &prefix, bool last)>;
+
+        /// Called in tree order for a directory that cannot be listed
+        using ErrorCallback = std::function<void(const std::wstring &path)>;
+
+        /// Called before waiting for a directory to be listed (a chance to flush output); false stops the walk
+        using IdleCallback = std::function<bool()>;
+
+        /**
+         * @param showHidden true to report hidden entries.
+         * @param workers    Number of listing threads; 0 picks one per core.
+         */
+        explicit TreeWalker(bool showHidden, unsigned workers = 0);
+
+        /**
+         * @brief Lists `root`, and with `recursive` every directory below it.
+         *
+         * Reparse points (links, junctions) are listed but not entered.
+         *
+         * @return false if the root could not be listed or a callback stopped the walk.
+         */
+        bool walk(const std::wstring &root, bool recursive, const EntryCallback &onEntry, const ErrorCallback &onError, const IdleCallback &onIdle);
+
+    private:
+        struct Node;
+
+        void list(Node &node, bool recursive) const;
+
+        bool m_showHidden;
+        unsigned m_workers;
+
+        std::atomic<uint32_t> m_listed{0}; ///< Bumped whenever a directory is listed; the reporting thread waits on it
+        std::atomic<bool> m_stop{false};
+    };
+}
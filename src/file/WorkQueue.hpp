@@ -0,0 +1,187 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\file\WorkQueue.hpp
+// PURPOSE: Per-worker task deques with work stealing, shared by the parallel file walkers.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <windows.h>
+
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress, WakeByAddress*
+
+namespace FileIO
+{
+    /**
+     * @brief Task deques for a fixed set of workers, with work stealing.
+     *
+     * A worker takes from the back of its own deque (newest first, so a
+     * tree walk stays depth-first) and steals from the front of the others'
+     * when its own is empty (oldest first, i.e. the biggest pending
+     * subtrees). Tasks may push more tasks. The queue is done once every
+     * pushed task has finished; workers then return from work().
+     *
+     * @tparam Task Movable task type.
+     */
+    template <typename Task>
+    class WorkQueue
+    {
+    public:
+        /**
+         * @param workers Number of workers; 0 picks one from the CPU count.
+         * @param perCore Workers per core when picking (file I/O mostly waits, so usually more than 1).
+         */
+        explicit WorkQueue(unsigned workers = 0, unsigned perCore = 2)
+        {
+            unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+            m_workers = workers ? workers : std::min(perCore * cores, 32u);
+
+            for (unsigned i = 0; i < m_workers; ++i)
+                m_queues.push_back(std::make_unique<Deque>());
+
+            m_doneEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        }
+
+        ~WorkQueue()
+        {
+            CloseHandle(m_doneEvent);
+        }
+
+        WorkQueue(const WorkQueue &) = delete;
+        WorkQueue &operator=(const WorkQueue &) = delete;
+
+        unsigned workers() const { return m_workers; }
+
+        /**
+         * @brief Adds a task to a worker's deque. Callable from any thread.
+         */
+        void push(unsigned worker, Task task)
+        {
+            m_pending.fetch_add(1, std::memory_order_acq_rel);
+
+            {
+                Deque &own = *m_queues[worker % m_workers];
+                std::lock_guard<std::mutex> guard(own.lock);
+                own.tasks.push_back(std::move(task));
+            }
+
+            m_generation.fetch_add(1, std::memory_order_release);
+            WakeByAddressSingle(&m_generation);
+        }
+
+        /**
+         * @brief Runs tasks on the calling thread until the queue is done.
+         *
+         * @param worker Index of this worker.
+         * @param run    Called as run(worker, task); may push more tasks.
+         */
+        template <typename Fn>
+        void work(unsigned worker, Fn &&run)
+        {
+            for (;;)
+            {
+                uint32_t generation = m_generation.load(std::memory_order_acquire);
+
+                Task task;
+                if (take(worker, task))
+                {
+                    run(worker, task);
+
+                    // Tasks pushed by `run` are counted already, so this only reaches 0 at the very end
+                    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        m_generation.fetch_add(1, std::memory_order_release);
+                        WakeByAddressAll(&m_generation);
+                        SetEvent(m_doneEvent);
+                    }
+                    continue;
+                }
+
+                if (m_pending.load(std::memory_order_acquire) == 0)
+                    return;
+
+                // Nothing to steal right now; sleep until something is pushed or all is done
+                WaitOnAddress(&m_generation, &generation, sizeof(generation), 10);
+            }
+        }
+
+        /**
+         * @brief Waits for every task to finish.
+         *
+         * @param milliseconds Timeout.
+         * @return true once the queue is done.
+         */
+        bool wait(DWORD milliseconds) const
+        {
+            return WaitForSingleObject(m_doneEvent, milliseconds) == WAIT_OBJECT_0;
+        }
+
+    private:
+        struct Deque
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        bool take(unsigned worker, Task &task)
+        {
+            {
+                Deque &own = *m_queues[worker];
+                std::lock_guard<std::mutex> guard(own.lock);
+
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    return true;
+                }
+            }
+
+            for (unsigned i = 1; i < m_workers; ++i)
+            {
+                Deque &victim = *m_queues[(worker + i) % m_workers];
+                std::lock_guard<std::mutex> guard(victim.lock);
+
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        unsigned m_workers = 0;
+        std::vector<std::unique_ptr<Deque>> m_queues;
+
+        std::atomic<uint64_t> m_pending{0};    ///< Tasks pushed but not finished
+        std::atomic<uint32_t> m_generation{0}; ///< Bumped on every push; idle workers wait on it
+        HANDLE m_doneEvent = nullptr;          ///< Manual-reset, set when m_pending drops to 0
+    };
+}
@@ -0,0 +1,93 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\headers\Ast.hpp
+// PURPOSE: Syntax tree built by 'src\core\Parser.cpp' and consumed by 'src\execution\Execution.cpp'.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Commands.hpp"
+
+namespace Ast
+{
+    /**
+     * @enum RedirectType
+     * @brief Which standard stream a redirection applies to.
+     */
+    enum class RedirectType : uint8_t
+    {
+        NONE,            ///< No redirection
+        STDIN,           ///< Input redirection '<'
+        STDOUT,          ///< Output redirection '>' or '>>'
+        STDERR,          ///< Error redirection '2>' or '2>>'
+        STDOUT_STDERR,   ///< Combined output and error '&>' or '&>>'
+        STDERR_TO_STDOUT ///< Error follows output '2>&1' (takes no target)
+    };
+
+    /**
+     * @struct Redirection
+     * @brief A single redirection attached to a command.
+     */
+    struct Redirection
+    {
+        RedirectType type = RedirectType::NONE;
+        bool append = false; ///< '>>', '2>>' or '&>>'
+        std::wstring target; ///< File path (empty for '2>&1')
+    };
+
+    /**
+     * @struct Command
+     * @brief One command of a pipeline.
+     *
+     * For built-ins, `args` holds the non-flag arguments and `flags` the
+     * parsed flag bits. For external programs, `args` holds the whole argv
+     * (program first, flags included) and `builtin` is RESERVED.
+     */
+    struct Command
+    {
+        CommandType builtin = CommandType::RESERVED;
+        uint16_t flags = 0;
+        std::vector<std::wstring> args;
+        std::vector<Redirection> redirections;
+
+        bool isBuiltin() const { return builtin != CommandType::RESERVED; }
+    };
+
+    /**
+     * @struct Pipeline
+     * @brief Commands connected with '|'.
+     */
+    struct Pipeline
+    {
+        std::vector<Command> commands;
+        bool background = false; ///< Terminated by '&'
+    };
+
+    /**
+     * @struct Sequence
+     * @brief Pipelines separated by ';' or '&', run in order. Root of a plan.
+     */
+    struct Sequence
+    {
+        std::vector<Pipeline> pipelines;
+    };
+}
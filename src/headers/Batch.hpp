@@ -0,0 +1,50 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\headers\Batch.hpp
+// PURPOSE: Header file for 'src\core\Batch.cpp'. Runs commands without the interactive prompt.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <string>
+
+namespace Batch
+{
+    /**
+     * @brief Returns true if esh should start the interactive prompt.
+     *
+     * Interactive mode needs no arguments and a console on stdin; anything
+     * else (arguments, a pipe, a redirected file) selects batch mode.
+     */
+    bool isInteractive(int argc);
+
+    /**
+     * @brief Runs esh in batch mode.
+     *
+     * Accepted forms:
+     *   esh -c "command"   Runs the given command line(s).
+     *   esh script.esh     Runs every line of a script file.
+     *   esh -              Reads lines from stdin (also the default when stdin is not a console).
+     *
+     * No prompt is painted, the line editor is not used and history is not
+     * loaded or saved. Blank lines and lines starting with '#' are skipped.
+     *
+     * @return Exit status of the last command that ran.
+     */
+    int run(int argc, wchar_t *argv[]);
+}
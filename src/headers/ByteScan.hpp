@@ -0,0 +1,85 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\headers\ByteScan.hpp
+// PURPOSE: Header file for 'src\core\ByteScan.cpp'. Vectorized byte searches over raw buffers.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bytescan
+{
+    /// @brief Whitespace as isspace() sees it in the C locale: space, \t, \n, \v, \f, \r.
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /// @brief Running totals of countText.
+    struct TextCounts
+    {
+        uint64_t lines = 0; ///< '\n' bytes
+        uint64_t words = 0; ///< Runs of non-whitespace
+    };
+
+    /**
+     * @brief Finds the last occurrence of a byte (a memrchr).
+     *
+     * Uses AVX2 when the CPU has it, SSE2 otherwise.
+     *
+     * @param data Buffer start.
+     * @param size Buffer size in bytes.
+     * @param byte Byte to look for.
+     * @return Pointer to the last match, or nullptr.
+     */
+    const char *findLast(const char *data, size_t size, char byte);
+
+    /**
+     * @brief Finds the n-th occurrence of a byte, counting from the start.
+     *
+     * Whole vectors of matches are counted at once, so sparse and dense
+     * input cost about the same. To search a stream block by block, pass
+     * the same `n` to each call: it counts down across blocks.
+     *
+     * @param data Buffer start.
+     * @param size Buffer size in bytes.
+     * @param byte Byte to look for.
+     * @param n    In: which occurrence (1 for the first). Out: how many are
+     *             still missing, 0 if found.
+     * @return Pointer to the n-th match, or nullptr if the buffer has fewer.
+     */
+    const char *findNth(const char *data, size_t size, char byte, size_t &n);
+
+    /**
+     * @brief Counts line breaks and words (like 'wc -l -w').
+     *
+     * Uses AVX2 when the CPU has it, SSE2 otherwise. Whitespace is what
+     * isSpace() accepts; every other byte, including UTF-8 sequences, is
+     * part of a word.
+     *
+     * @param data   Buffer start.
+     * @param size   Buffer size in bytes.
+     * @param counts Totals to add to.
+     * @param inWord In: whether the byte before `data` was inside a word
+     *               (false at the start of input). Out: whether the last
+     *               byte is. Lets a stream be counted block by block.
+     */
+    void countText(const char *data, size_t size, TextCounts &counts, bool &inWord);
+}
@@ -16,37 +16,47 @@ limitations under the License.
 
 // FILE: src\headers\Commands.hpp
 // PURPOSE: Header file for 'src\core\Commands.cpp'. Commands' and flags' definitons are made here.
-// DO NOT FORGET to check 'esh.json'.
+// DO NOT FORGET to check 'esh.json'. (It only holds help text; the lists below are the source of truth.)
 
 #pragma once
 
-// --------- DEFINE COMMAND CONSTANTS ----------------
-// Command Types                         Hex Values  |
+// ------------ DECLARE BUILT-IN COMMANDS ------------
+// Every built-in command is declared exactly once   |
+// here. The CommandType enum, the lookup table and  |
+// getCommandGroup() are all generated from it.      |
+//                                                   |
+//  X(ENUM NAME,   "name",        Hex, Group)        |
 // ---------------------------------------------------
-#define COMMAND_RESERVED                    0x00
-#define COMMAND_LS                          0x01
-#define COMMAND_PWD                         0x02
-#define COMMAND_EXIT                        0x03
-#define COMMAND_CD                          0x04
-#define COMMAND_WHOAMI                      0x05
-#define COMMAND_DATETIME                    0x06
-#define COMMAND_HOSTNAME                    0x07
-#define COMMAND_PS                          0x08
-#define COMMAND_TOUCH                       0x09
-#define COMMAND_RM                          0x0A
-#define COMMAND_MKDIR                       0x0B
-#define COMMAND_RMDIR                       0x0C
-#define COMMAND_CLEAR                       0x0D
-#define COMMAND_MV                          0x0E
-#define COMMAND_CP                          0x0F
-#define COMMAND_SYSTEMINFO                  0x10
-#define COMMAND_SYSTEMSTATS                 0x11
-#define COMMAND_REW                         0x12
-#define COMMAND_ECHO                        0x13
-#define COMMAND_STATS                       0x14
-#define COMMAND_HEAD                        0x15
-#define COMMAND_TAIL                        0x16
-#define COMMAND_KILL                        0x17
+#define ESH_COMMANDS(X)                                 \
+    X(LS,          L"ls",          0x01, FILE_IO)       \
+    X(PWD,         L"pwd",         0x02, ENVIRONMENT)   \
+    X(EXIT,        L"exit",        0x03, SHELL)         \
+    X(CD,          L"cd",          0x04, ENVIRONMENT)   \
+    X(WHOAMI,      L"whoami",      0x05, ENVIRONMENT)   \
+    X(DATETIME,    L"datetime",    0x06, ENVIRONMENT)   \
+    X(HOSTNAME,    L"hostname",    0x07, ENVIRONMENT)   \
+    X(PS,          L"ps",          0x08, PROCESS)       \
+    X(TOUCH,       L"touch",       0x09, FILE_IO)       \
+    X(RM,          L"rm",          0x0A, FILE_IO)       \
+    X(MKDIR,       L"mkdir",       0x0B, FILE_IO)       \
+    X(RMDIR,       L"rmdir",       0x0C, FILE_IO)       \
+    X(CLEAR,       L"clear",       0x0D, SHELL)         \
+    X(MV,          L"mv",          0x0E, FILE_IO)       \
+    X(CP,          L"cp",          0x0F, FILE_IO)       \
+    X(SYSTEMINFO,  L"systeminfo",  0x10, SYSTEM)        \
+    X(SYSTEMSTATS, L"systemstats", 0x11, SYSTEM)        \
+    X(REW,         L"rew",         0x12, FILE_IO)       \
+    X(ECHO,        L"echo",        0x13, SHELL)         \
+    X(STATS,       L"stats",       0x14, FILE_IO)       \
+    X(HEAD,        L"head",        0x15, FILE_IO)       \
+    X(TAIL,        L"tail",        0x16, FILE_IO)       \
+    X(KILL,        L"kill",        0x17, PROCESS)       \
+    X(JOBS,        L"jobs",        0x18, PROCESS)       \
+    X(FG,          L"fg",          0x19, PROCESS)       \
+    X(BG,          L"bg",          0x1A, PROCESS)       \
+    X(WAIT,        L"wait",        0x1B, PROCESS)       \
+    X(PIPESTAT,    L"pipestat",    0x1C, PROCESS)       \
+    X(CACHE,       L"cache",       0x1D, SHELL)
 
 // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-
 
@@ -61,25 +71,41 @@ limitations under the License.
 #define FLAG_ALL                            0x08   // -a                           00001000
 #define FLAG_HELP                           0x10   // --help                       00010000
 #define FLAG_COUNT                          0x20   // -n (used for line counts)    00100000
+#define FLAG_FOLLOW                         0x40   // -F (tail: follow by name)    01000000
+#define FLAG_BYTES                          0x80   // -c (used for byte counts)    10000000
+#define FLAG_RESUME                         0x100  // --resume (mv: finish)        100000000
+#define FLAG_ROLLBACK                       0x200  // --rollback (mv: undo)        1000000000
+
+//  X(ENUM NAME,  "flag",        Value)
+#define ESH_FLAGS(X)                                \
+    X(RECURSIVE,  L"-r",         FLAG_RECURSIVE)    \
+    X(VERBOSE,    L"-v",         FLAG_VERBOSE)      \
+    X(FORCE,      L"-f",         FLAG_FORCE)        \
+    X(ALL,        L"-a",         FLAG_ALL)          \
+    X(HELP,       L"--help",     FLAG_HELP)         \
+    X(COUNT,      L"-n",         FLAG_COUNT)        \
+    X(FOLLOW,     L"-F",         FLAG_FOLLOW)       \
+    X(BYTES,      L"-c",         FLAG_BYTES)        \
+    X(RESUME,     L"--resume",   FLAG_RESUME)       \
+    X(ROLLBACK,   L"--rollback", FLAG_ROLLBACK)
 
 // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-
 
 
 
-// ------------------ DEFINE SYMBOLS  ----------------
-// Symbol Types                           Hex Values |
+// ------------------ DECLARE SYMBOLS ----------------
+//  X(ENUM NAME,                     "symbol", Hex)  |
 // ---------------------------------------------------
-#define SYMBOL_OUTPUT_REDIRECTION_ONE        0x01 // >
-#define SYMBOL_OUTPUT_REDIRECTION_TWO        0x02 // >>
-#define SYMBOL_INPUT_REDIRECTION             0x03 // <
-
-#define SYMBOL_ERROR_REDIRECTION_ONE         0x04 // 2>
-#define SYMBOL_ERROR_REDIRECTION_TWO         0x05 // 2>>
-
-#define SYMBOL_OUTPUT_ERROR_REDIRECTION_ONE  0x06 // &>
-#define SYMBOL_OUTPUT_ERROR_REDIRECTION_TWO  0x07 // &>>
-
-#define SYMBOL_PIPELINE                      0x08 // |
+#define ESH_SYMBOLS(X)                                  \
+    X(OUTPUT_REDIRECTION_ONE,        L">",     0x01)    \
+    X(OUTPUT_REDIRECTION_TWO,        L">>",    0x02)    \
+    X(INPUT_REDIRECTION,             L"<",     0x03)    \
+    X(ERROR_REDIRECTION_ONE,         L"2>",    0x04)    \
+    X(ERROR_REDIRECTION_TWO,         L"2>>",   0x05)    \
+    X(OUTPUT_ERROR_REDIRECTION_ONE,  L"&>",    0x06)    \
+    X(OUTPUT_ERROR_REDIRECTION_TWO,  L"&>>",   0x07)    \
+    X(PIPELINE,                      L"|",     0x08)    \
+    X(ERROR_TO_OUTPUT_REDIRECTION,   L"2>&1",  0x09)
 
 // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-
 
@@ -87,71 +113,43 @@ limitations under the License.
 // INCLUDE LIBRARIES
 
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <cstdint>
 
-#include "Shell.hpp"
+#include "PerfectHash.hpp"
 
 class Commands
 {
 public:
-    static bool isBuiltInCommand(const std::wstring &command);
+    static bool isBuiltInCommand(std::wstring_view command);
 };
 
 // DEFINE COMMAND TYPES
 enum class CommandType : uint8_t
 {
-    RESERVED =       COMMAND_RESERVED,
-    LS =             COMMAND_LS,
-    PWD =            COMMAND_PWD,
-    EXIT =           COMMAND_EXIT,
-    CD =             COMMAND_CD,
-    WHOAMI =         COMMAND_WHOAMI,
-    DATETIME =       COMMAND_DATETIME,
-    HOSTNAME =       COMMAND_HOSTNAME,
-    TOUCH =          COMMAND_TOUCH,
-    RM =             COMMAND_RM,
-    MKDIR =          COMMAND_MKDIR,
-    RMDIR =          COMMAND_RMDIR,
-    CLEAR =          COMMAND_CLEAR,
-    MV =             COMMAND_MV,
-    CP =             COMMAND_CP,
-    SYSTEMINFO =     COMMAND_SYSTEMINFO,
-    SYSTEMSTATS =    COMMAND_SYSTEMSTATS,
-    REW =            COMMAND_REW,
-    ECHO =           COMMAND_ECHO,
-    STATS =          COMMAND_STATS,
-    HEAD =           COMMAND_HEAD,
-    TAIL =           COMMAND_TAIL,
-    PS =             COMMAND_PS,
-    KILL =           COMMAND_KILL
+    RESERVED = 0x00,
+#define ESH_COMMAND_ENUM(NAME, TEXT, VALUE, GROUP) NAME = VALUE,
+    ESH_COMMANDS(ESH_COMMAND_ENUM)
+#undef ESH_COMMAND_ENUM
 };
 
 // DEFINE FLAGS
 enum class Flag : uint16_t
 {
-    RECURSIVE =     FLAG_RECURSIVE,
-    VERBOSE =       FLAG_VERBOSE,
-    FORCE =         FLAG_FORCE,
-    ALL =           FLAG_ALL,
-    HELP =          FLAG_HELP,
-    COUNT =         FLAG_COUNT 
+#define ESH_FLAG_ENUM(NAME, TEXT, VALUE) NAME = VALUE,
+    ESH_FLAGS(ESH_FLAG_ENUM)
+#undef ESH_FLAG_ENUM
 };
 
 // DEFINE SYMBOLS
-
 enum class Symbol : uint8_t
 {
-    OUTPUT_REDIRECTION_ONE =            SYMBOL_OUTPUT_REDIRECTION_ONE,
-    OUTPUT_REDIRECTION_TWO =            SYMBOL_OUTPUT_REDIRECTION_TWO,
-    INPUT_REDIRECTION =                 SYMBOL_INPUT_REDIRECTION,
-    ERROR_REDIRECTION_ONE =             SYMBOL_ERROR_REDIRECTION_ONE,
-    ERROR_REDIRECTION_TWO =             SYMBOL_ERROR_REDIRECTION_TWO,
-    OUTPUT_ERROR_REDIRECTION_ONE =      SYMBOL_OUTPUT_ERROR_REDIRECTION_ONE,
-    OUTPUT_ERROR_REDIRECTION_TWO =      SYMBOL_OUTPUT_ERROR_REDIRECTION_TWO,
-    PIPELINE =                          SYMBOL_PIPELINE
-
+    NONE = 0x00,
+#define ESH_SYMBOL_ENUM(NAME, TEXT, VALUE) NAME = VALUE,
+    ESH_SYMBOLS(ESH_SYMBOL_ENUM)
+#undef ESH_SYMBOL_ENUM
 };
+
 // COMMAND GROUP FOR ENGINE
 enum class CommandGroup : uint8_t
 {
@@ -163,99 +161,56 @@ enum class CommandGroup : uint8_t
     UNKNOWN
 };
 
-// MAP COMMAND STRINGS TO COMMAND TYPES
-static inline const std::unordered_map<std::wstring, CommandType> commandMap = {
-    {L"ls", CommandType::LS},
-    {L"pwd", CommandType::PWD},
-    {L"exit", CommandType::EXIT},
-    {L"cd", CommandType::CD},
-    {L"whoami", CommandType::WHOAMI},
-    {L"datetime", CommandType::DATETIME},
-    {L"hostname", CommandType::HOSTNAME},
-    {L"touch", CommandType::TOUCH},
-    {L"rm", CommandType::RM},
-    {L"mkdir", CommandType::MKDIR},
-    {L"rmdir", CommandType::RMDIR},
-    {L"clear", CommandType::CLEAR},
-    {L"mv", CommandType::MV},
-    {L"cp", CommandType::CP},
-    {L"systeminfo", CommandType::SYSTEMINFO},
-    {L"systemstats", CommandType::SYSTEMSTATS},
-    {L"rew", CommandType::REW},
-    {L"echo", CommandType::ECHO},
-    {L"stats", CommandType::STATS},
-    {L"head", CommandType::HEAD},
-    {L"tail", CommandType::TAIL},
-    {L"ps", CommandType::PS},
-    {L"kill", CommandType::KILL}
-};
+// PERFECT HASH TABLES (built at compile time, no static initialization)
 
-// MAP FLAG STRINGS TO FLAG TYPES
-static inline const std::unordered_map<std::wstring, Flag> flagMap = {
-    {L"-r", Flag::RECURSIVE},
-    {L"-v", Flag::VERBOSE},
-    {L"-f", Flag::FORCE},
-    {L"-a", Flag::ALL},
-    {L"--help", Flag::HELP},
-    {L"-n", Flag::COUNT}
+inline constexpr phash::Entry<CommandType> commandEntries[] = {
+#define ESH_COMMAND_ENTRY(NAME, TEXT, VALUE, GROUP) {TEXT, CommandType::NAME},
+    ESH_COMMANDS(ESH_COMMAND_ENTRY)
+#undef ESH_COMMAND_ENTRY
 };
 
-// MAP SYMBOL STRINGS TO SYMBOL TYPES
-static inline const std::unordered_map<std::wstring, Symbol> symbolMap = {
-    {L">", Symbol::OUTPUT_REDIRECTION_ONE},
-    {L">>", Symbol::OUTPUT_REDIRECTION_TWO},
-    {L"<", Symbol::INPUT_REDIRECTION},
-    {L"2>", Symbol::ERROR_REDIRECTION_ONE},
-    {L"2>>", Symbol::ERROR_REDIRECTION_TWO},
-    {L"&>", Symbol::OUTPUT_ERROR_REDIRECTION_ONE},
-    {L"&>>", Symbol::OUTPUT_ERROR_REDIRECTION_TWO},
-    {L"|", Symbol::PIPELINE}
+inline constexpr phash::Entry<Flag> flagEntries[] = {
+#define ESH_FLAG_ENTRY(NAME, TEXT, VALUE) {TEXT, Flag::NAME},
+    ESH_FLAGS(ESH_FLAG_ENTRY)
+#undef ESH_FLAG_ENTRY
 };
 
+// MAP COMMAND STRINGS TO COMMAND TYPES
+inline constexpr auto commandTable = phash::makeTable<128>(commandEntries);
+static_assert(commandTable.valid(), "No collision-free seed for the command table; grow its slot count");
+
+// MAP FLAG STRINGS TO FLAG TYPES
+inline constexpr auto flagTable = phash::makeTable<32>(flagEntries);
+static_assert(flagTable.valid(), "No collision-free seed for the flag table; grow its slot count");
+
 // Get command group from command given.
-inline CommandGroup getCommandGroup(CommandType cmd)
+constexpr CommandGroup getCommandGroup(CommandType cmd)
 {
     switch (cmd)
     {
-    // -------- FILE COMMANDS --------
-    case CommandType::LS:
-    case CommandType::STATS:
-    case CommandType::HEAD:
-    case CommandType::TAIL:
-    case CommandType::TOUCH:
-    case CommandType::RM:
-    case CommandType::CP:
-    case CommandType::MV:
-    case CommandType::MKDIR:
-    case CommandType::RMDIR:
-    case CommandType::REW:
-        return CommandGroup::FILE_IO;
-
-    // -------- PROCESS COMMANDS --------
-    case CommandType::PS:
-    case CommandType::KILL:
-        return CommandGroup::PROCESS;
-
-    // -------- ENVIRONMENT COMMANDS --------
-    case CommandType::CD:
-    case CommandType::PWD:
-    case CommandType::WHOAMI:
-    case CommandType::DATETIME:
-    case CommandType::HOSTNAME:
-        return CommandGroup::ENVIRONMENT;
-
-    // -------- SHELL COMMANDS --------
-    case CommandType::EXIT:
-    case CommandType::CLEAR:
-    case CommandType::ECHO:
-        return CommandGroup::SHELL;
-
-    // -------- SYSTEM COMMANDS --------
-    case CommandType::SYSTEMINFO:
-    case CommandType::SYSTEMSTATS:
-        return CommandGroup::SYSTEM;
+#define ESH_COMMAND_GROUP(NAME, TEXT, VALUE, GROUP) \
+    case CommandType::NAME:                         \
+        return CommandGroup::GROUP;
+        ESH_COMMANDS(ESH_COMMAND_GROUP)
+#undef ESH_COMMAND_GROUP
 
     default:
         return CommandGroup::UNKNOWN;
     }
 }
+
+// Get the command's name as typed by the user (empty for unknown commands).
+constexpr std::wstring_view commandName(CommandType cmd)
+{
+    switch (cmd)
+    {
+#define ESH_COMMAND_NAME(NAME, TEXT, VALUE, GROUP) \
+    case CommandType::NAME:                        \
+        return TEXT;
+        ESH_COMMANDS(ESH_COMMAND_NAME)
+#undef ESH_COMMAND_NAME
+
+    default:
+        return {};
+    }
+}
@@ -26,6 +26,8 @@ limitations under the License.
 
 #include <windows.h>
 
+#include "Unicode.hpp"
+
 enum class ConsoleColor : WORD // Color adjustments
 {
     Default = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE, // White
@@ -57,13 +59,20 @@ namespace console
 
     inline void write(const std::wstring &text)
     {
+        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+
         DWORD written;
-        WriteConsoleW(
-            GetStdHandle(STD_OUTPUT_HANDLE),
-            text.c_str(),
-            static_cast<DWORD>(text.size()),
-            &written,
-            nullptr);
+        if (WriteConsoleW(
+                hOut,
+                text.c_str(),
+                static_cast<DWORD>(text.size()),
+                &written,
+                nullptr))
+            return;
+
+        // stdout is a file or pipe (e.g. 'esh -c ... > out.txt'): write UTF-8 bytes instead
+        std::string utf8 = unicode::utf16_to_utf8(text);
+        WriteFile(hOut, utf8.data(), static_cast<DWORD>(utf8.size()), &written, nullptr);
     }
 
     inline void writeln(const std::wstring &text)
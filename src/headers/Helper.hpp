@@ -208,12 +208,7 @@ namespace helper
 
     inline std::wstring commandTypeToString(CommandType type)
     {
-        for (const auto &[name, cmd] : commandMap)
-        {
-            if (cmd == type)
-                return name;
-        }
-        return L"";
+        return std::wstring(commandName(type));
     }
 
     inline void showHelp(CommandType command)
@@ -22,7 +22,9 @@ limitations under the License.
 // INCLUDE LIBRARIES
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
 
 class Lexer
 {
@@ -73,6 +75,8 @@ public:
         TOKEN_OUTPUT_ERROR_REDIRECTION_ONE,  /** &>  */
         TOKEN_OUTPUT_ERROR_REDIRECTION_TWO,  /** &>> */
 
+        TOKEN_ERROR_TO_OUTPUT_REDIRECTION,   /** 2>&1 */
+
         TOKEN_PIPELINE,                      /** |   */
 
         TOKEN_EOF                            /** End of input */
@@ -80,11 +84,28 @@ public:
 
     /**
      * @brief Represents a single token with its type and lexeme.
+     *
+     * The lexeme is a view into either the raw input line or the owning
+     * TokenStream's storage; it is only valid while both are alive.
      */
     struct Token
     {
         TokenType type;
-        std::wstring lexeme;
+        std::wstring_view lexeme;
+    };
+
+    /**
+     * @brief Output of the lexer for a single input line.
+     *
+     * Plain words are views straight into the input line. Words that
+     * contained quotes or escapes are unescaped once into `storage`, which
+     * is sized for the whole line up front so views never move.
+     */
+    struct TokenStream
+    {
+        std::vector<Token> tokens;
+        std::unique_ptr<wchar_t[]> storage; ///< Backing text for unescaped words
+        std::size_t storageUsed = 0;        ///< Characters consumed in storage
     };
 
 };
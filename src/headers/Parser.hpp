@@ -21,19 +21,24 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Lexer.hpp"
 #include "Commands.hpp"
-#include "../execution/Execution.hpp"
+#include "Ast.hpp"
+#include "Result.hpp"
 
 class Parser
 {
 public:
-    static void parseTokens(const std::vector<Lexer::Token> &tokens, Execution::Executor::Context& ctx);
+    static Result<std::shared_ptr<const Ast::Sequence>> parseTokens(const std::vector<Lexer::Token> &tokens);
 
-    static CommandType parseCommand(const std::wstring &token);
+    static CommandType parseCommand(std::wstring_view token);
+
+    static uint16_t parseFlag(std::wstring_view token);
 
     static uint16_t parseFlags(const std::vector<std::wstring> &tokens);
 };
\ No newline at end of file
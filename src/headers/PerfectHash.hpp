@@ -0,0 +1,168 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\headers\PerfectHash.hpp
+// PURPOSE: Compile-time perfect hash tables for keyword lookups (commands, flags).
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace phash
+{
+    /**
+     * @brief Seeded FNV-1a over UTF-16 code units with a final avalanche step.
+     *
+     * @param key  Key to hash.
+     * @param seed Seed chosen at compile time by Table.
+     * @return 32-bit hash value.
+     */
+    constexpr uint32_t hash(std::wstring_view key, uint32_t seed)
+    {
+        uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (wchar_t ch : key)
+        {
+            h ^= static_cast<uint32_t>(ch);
+            h *= 16777619u;
+        }
+
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        return h;
+    }
+
+    /**
+     * @brief A single keyword and the value it maps to.
+     */
+    template <typename T>
+    struct Entry
+    {
+        std::wstring_view key;
+        T value;
+    };
+
+    /**
+     * @brief Collision-free open table built entirely at compile time.
+     *
+     * The constructor searches for a seed under which every key lands in
+     * its own slot, so a lookup is one hash, one mask and one comparison,
+     * with no allocation and no static-initialization work at startup.
+     *
+     * @tparam T     Value type.
+     * @tparam N     Number of keys.
+     * @tparam Slots Slot count; must be a power of two and at least N.
+     */
+    template <typename T, std::size_t N, std::size_t Slots>
+    class Table
+    {
+        static_assert((Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+        static_assert(Slots >= N, "Slots must be at least the number of keys");
+
+    public:
+        static constexpr uint32_t NO_SEED = 0xFFFFFFFFu;
+        static constexpr uint32_t MAX_SEED_ATTEMPTS = 4096;
+
+        constexpr explicit Table(const Entry<T> (&entries)[N])
+            : m_seed(findSeed(entries)), m_slots{}
+        {
+            if (m_seed == NO_SEED)
+                return;
+
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                Slot &slot = m_slots[hash(entries[i].key, m_seed) & (Slots - 1)];
+                slot.key = entries[i].key;
+                slot.value = entries[i].value;
+                slot.used = true;
+            }
+        }
+
+        /**
+         * @brief True if a collision-free seed was found (checked via static_assert).
+         */
+        constexpr bool valid() const { return m_seed != NO_SEED; }
+
+        /**
+         * @brief Looks up a key.
+         *
+         * @param key      Key to look up.
+         * @param fallback Value returned when the key is not in the table.
+         * @return The mapped value, or `fallback`.
+         */
+        constexpr T lookup(std::wstring_view key, T fallback) const
+        {
+            const Slot &slot = m_slots[hash(key, m_seed) & (Slots - 1)];
+            return (slot.used && slot.key == key) ? slot.value : fallback;
+        }
+
+        /**
+         * @brief True if the key is in the table.
+         */
+        constexpr bool contains(std::wstring_view key) const
+        {
+            const Slot &slot = m_slots[hash(key, m_seed) & (Slots - 1)];
+            return slot.used && slot.key == key;
+        }
+
+    private:
+        struct Slot
+        {
+            std::wstring_view key{};
+            T value{};
+            bool used = false;
+        };
+
+        static constexpr uint32_t findSeed(const Entry<T> (&entries)[N])
+        {
+            for (uint32_t seed = 0; seed < MAX_SEED_ATTEMPTS; ++seed)
+            {
+                bool taken[Slots] = {};
+                bool collision = false;
+
+                for (std::size_t i = 0; i < N && !collision; ++i)
+                {
+                    const std::size_t index = hash(entries[i].key, seed) & (Slots - 1);
+                    collision = taken[index];
+                    taken[index] = true;
+                }
+
+                if (!collision)
+                    return seed;
+            }
+
+            return NO_SEED;
+        }
+
+        uint32_t m_seed;
+        Slot m_slots[Slots];
+    };
+
+    /**
+     * @brief Builds a Table, deducing the value type and key count.
+     *
+     * @tparam Slots Slot count (power of two).
+     */
+    template <std::size_t Slots, typename T, std::size_t N>
+    constexpr Table<T, N, Slots> makeTable(const Entry<T> (&entries)[N])
+    {
+        return Table<T, N, Slots>(entries);
+    }
+}
@@ -0,0 +1,91 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\headers\PlanCache.hpp
+// PURPOSE: Header file for 'src\core\PlanCache.cpp'. Caches parsed plans keyed by the raw input line.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "Ast.hpp"
+
+/**
+ * @class PlanCache
+ * @brief Least-recently-used cache of validated plans.
+ *
+ * A line that was parsed successfully once is looked up here first, so
+ * re-running it (from history or a script loop) skips lexing and parsing.
+ * Plans are immutable and shared, so a hit costs one hash lookup.
+ */
+class PlanCache
+{
+public:
+    using Plan = std::shared_ptr<const Ast::Sequence>;
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        std::size_t size = 0;
+        std::size_t capacity = 0;
+    };
+
+    static PlanCache &instance();
+
+    /**
+     * @brief Looks up a line and marks it most recently used.
+     *
+     * @param line Raw input line.
+     * @return The cached plan, or nullptr on a miss.
+     */
+    Plan find(const std::wstring &line);
+
+    /**
+     * @brief Stores a plan, evicting the least recently used one when full.
+     *
+     * @param line Raw input line (copied into the cache).
+     * @param plan Validated plan.
+     */
+    void insert(const std::wstring &line, Plan plan);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+    explicit PlanCache(std::size_t capacity) : m_capacity(capacity) {}
+
+    using Entry = std::pair<std::wstring, Plan>;
+
+    std::list<Entry> m_entries; ///< Front is most recently used
+    std::unordered_map<std::wstring_view, std::list<Entry>::iterator> m_index; ///< Keys view into m_entries
+
+    std::size_t m_capacity;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
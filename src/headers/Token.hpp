@@ -23,6 +23,7 @@ limitations under the License.
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "Lexer.hpp"
 #include "../execution/Execution.hpp"
@@ -32,19 +33,19 @@ class Token {
     public:
         /**
          * @brief Tokenizes the input string into a sequence of tokens.
-         * @param input The raw input string.
+         * @param input The raw input string. Must outlive the produced tokens.
+         * @param out   Receives the tokens and any unescaped word storage.
          * @param ctx   Execution context (tracks pipeline/redirection state).
-         * @return A vector of tokens.
          */
-        static std::vector<Lexer::Token> tokenizeInput(const std::wstring &input, Execution::Executor::Context &ctx);
+        static void tokenizeInput(std::wstring_view input, Lexer::TokenStream &out, Execution::Executor::Context &ctx);
 
         /**
-         * @brief Identifies the type of a given token string.
-         * @param token The token string.
-         * @param ctx   Execution context (updated if pipeline/redirection detected).
+         * @brief Identifies the type of an unquoted word.
+         * @param token           The word text.
+         * @param commandPosition True if the word starts a command (line start, after '|', ';' or '&').
          * @return The token type.
          */
-        static Lexer::TokenType identifyTokenType(const std::wstring &token, Execution::Executor::Context &ctx);
+        static Lexer::TokenType identifyTokenType(std::wstring_view token, bool commandPosition);
 
 };
 
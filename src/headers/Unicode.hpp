@@ -27,4 +27,5 @@ namespace unicode
 {
     std::wstring utf8_to_utf16(const std::string &utf8);
     std::string utf16_to_utf8(const std::wstring &utf16);
+    size_t utf8_complete_length(const char *data, size_t size);
 }
\ No newline at end of file
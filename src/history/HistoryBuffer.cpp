@@ -19,46 +19,252 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <algorithm>
+
+#include "../headers/Unicode.hpp"
 #include "HistoryBuffer.hpp"
 
+// HELPER FUNCTIONS
+
+/// @brief One hour in FILETIME units (100 ns).
+static constexpr uint64_t HOUR = 36000000000ull;
+
+/// @brief Retired positions tolerated before a compaction, at least.
+static constexpr size_t MIN_RETIRED = 4096;
+
+static uint64_t now()
+{
+    FILETIME time;
+    GetSystemTimeAsFileTime(&time);
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
 namespace History
 {
 
+    void Buffer::load(Store store, size_t capacity)
+    {
+        m_store = std::move(store);
+        m_added.clear();
+        m_addedEnds.clear();
+        m_addedTimes.clear();
+
+        m_capacity = std::max<size_t>(capacity, 1);
+        m_index.clear();
+        m_uses.assign(m_store.size(), 0);
+        m_live = 0;
+        m_oldest = 0;
+        m_maxUses = 0;
+
+        // Hashes the mapped bytes; nothing is decoded
+        for (size_t i = 0; i < m_store.size(); ++i)
+            add(m_store.text(i), std::max<uint32_t>(m_store.uses(i), 1), i);
+
+        m_cursor = size();
+    }
+
     void Buffer::push(const std::wstring &command)
     {
-        m_entries.push_back(command);
-        m_cursor = m_entries.size(); // always reset to end
+        const std::string text = unicode::utf16_to_utf8(command);
+
+        m_added += text;
+        m_addedEnds.push_back(static_cast<uint32_t>(m_added.size()));
+        m_addedTimes.push_back(now());
+        m_uses.push_back(0);
+
+        add(text, 1, size() - 1);
+        m_cursor = size(); // always reset to end
+    }
+
+    /// @brief Makes `index` the live entry of `text`, retiring an older one and taking over its uses.
+    void Buffer::add(std::string_view text, uint32_t uses, size_t index)
+    {
+        auto [it, added] = m_index.try_emplace(Store::hash(text), static_cast<uint32_t>(index));
+        if (!added)
+        {
+            const size_t older = it->second;
+            if (m_uses[older] && this->text(older) == text)
+            {
+                uses += m_uses[older];
+                m_uses[older] = 0;
+                --m_live;
+            }
+
+            it->second = static_cast<uint32_t>(index);
+        }
+
+        m_uses[index] = uses;
+        m_maxUses = std::max(m_maxUses, uses);
+        ++m_live;
+        trim();
+    }
+
+    /// @brief Retires the oldest commands until at most `capacity` are live.
+    void Buffer::trim()
+    {
+        while (m_live > m_capacity)
+        {
+            while (!m_uses[m_oldest])
+                ++m_oldest;
+
+            auto it = m_index.find(Store::hash(text(m_oldest)));
+            if (it != m_index.end() && it->second == m_oldest)
+                m_index.erase(it);
+
+            m_uses[m_oldest++] = 0;
+            --m_live;
+        }
     }
 
     std::optional<std::wstring> Buffer::previous()
     {
-        if (m_entries.empty() || m_cursor == 0)
-            return std::nullopt;
+        for (size_t i = m_cursor; i > 0;)
+        {
+            if (live(--i))
+            {
+                m_cursor = i;
+                return at(i);
+            }
+        }
 
-        --m_cursor;
-        return m_entries[m_cursor];
+        return std::nullopt;
     }
 
     std::optional<std::wstring> Buffer::next()
     {
-        if (m_cursor >= m_entries.size() - 1)
+        for (size_t i = m_cursor + 1; i < size(); ++i)
         {
-            m_cursor = m_entries.size();
-            return std::nullopt;
+            if (live(i))
+            {
+                m_cursor = i;
+                return at(i);
+            }
         }
 
-        ++m_cursor;
-        return m_entries[m_cursor];
+        m_cursor = size();
+        return std::nullopt;
     }
 
     void Buffer::resetNavigation()
     {
-        m_cursor = m_entries.size();
+        m_cursor = size();
+    }
+
+    size_t Buffer::size() const
+    {
+        return m_store.size() + m_addedEnds.size();
+    }
+
+    bool Buffer::live(size_t index) const
+    {
+        return index < m_uses.size() && m_uses[index] > 0;
+    }
+
+    std::wstring Buffer::at(size_t index) const
+    {
+        if (index < m_store.size())
+            return m_store.command(index);
+
+        return unicode::utf8_to_utf16(std::string(text(index)));
+    }
+
+    std::string_view Buffer::text(size_t index) const
+    {
+        if (!live(index))
+            return {};
+
+        if (index < m_store.size())
+            return m_store.text(index);
+
+        index -= m_store.size();
+
+        const size_t start = index ? m_addedEnds[index - 1] : 0;
+        return std::string_view(m_added).substr(start, m_addedEnds[index] - start);
+    }
+
+    uint32_t Buffer::uses(size_t index) const
+    {
+        return index < m_uses.size() ? m_uses[index] : 0;
+    }
+
+    uint64_t Buffer::time(size_t index) const
+    {
+        if (index < m_store.size())
+            return m_store.time(index);
+
+        index -= m_store.size();
+        return index < m_addedTimes.size() ? m_addedTimes[index] : 0;
+    }
+
+    double Buffer::frecency(size_t index) const
+    {
+        return uses(index) * recency(index);
+    }
+
+    double Buffer::recency(size_t index) const
+    {
+        const uint64_t current = now();
+        const uint64_t last = time(index);
+        const uint64_t age = current > last ? current - last : 0;
+
+        // Recent use counts more; a command without a time (older formats) counts least
+        return age < HOUR            ? 4.0
+               : age < 24 * HOUR     ? 2.0
+               : age < 7 * 24 * HOUR ? 1.0
+               : age < 30 * 24 * HOUR ? 0.5
+                                      : 0.25;
+    }
+
+    uint32_t Buffer::maxUses() const
+    {
+        return m_maxUses;
+    }
+
+    bool Buffer::compactDue() const
+    {
+        return size() - m_live > std::max(m_live, MIN_RETIRED);
+    }
+
+    void Buffer::compact()
+    {
+        std::string added;
+        std::vector<uint32_t> ends;
+        std::vector<uint64_t> times;
+        std::vector<uint32_t> uses;
+
+        added.reserve(m_added.size());
+        ends.reserve(m_live);
+        times.reserve(m_live);
+        uses.reserve(m_live);
+        m_index.clear();
+
+        for (size_t i = 0; i < size(); ++i)
+        {
+            if (!live(i))
+                continue;
+
+            const std::string_view entry = text(i);
+            m_index[Store::hash(entry)] = static_cast<uint32_t>(ends.size());
+
+            added += entry;
+            ends.push_back(static_cast<uint32_t>(added.size()));
+            times.push_back(time(i));
+            uses.push_back(m_uses[i]);
+        }
+
+        m_store = Store(); // everything lives in memory now; the log is free to be compacted
+        m_added = std::move(added);
+        m_addedEnds = std::move(ends);
+        m_addedTimes = std::move(times);
+        m_uses = std::move(uses);
+        m_maxUses = m_uses.empty() ? 0 : *std::max_element(m_uses.begin(), m_uses.end());
+        m_oldest = 0;
+        m_cursor = size();
     }
 
-    const std::vector<std::wstring> &Buffer::entries() const
+    const Store &Buffer::store() const
     {
-        return m_entries;
+        return m_store;
     }
 
 }
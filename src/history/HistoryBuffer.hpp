@@ -21,16 +21,37 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <cstdint>
 #include <vector>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "HistoryStore.hpp"
 
 namespace History
 {
+    /**
+     * @brief The history in memory: the loaded log plus this session's commands.
+     *
+     * Loaded entries stay in the mapped log and are decoded only when
+     * navigation reaches them. Commands added since are kept as UTF-8,
+     * back to back in one string.
+     *
+     * Each command appears once: a hash index from its text to its newest
+     * position lets a repeated command retire the older entry and take
+     * over its use count. Retired positions stay (they are skipped), so
+     * positions never shift until compact() renumbers them. At most
+     * `capacity` commands are live; beyond that the oldest are retired.
+     */
     class Buffer
     {
         public:
-            // Add command to history
+            // Take over the history loaded from disk, keeping at most `capacity` commands
+            void load(Store store, size_t capacity);
+
+            // Add command to history, retiring an older copy of it
             void push(const std::wstring &command);
 
             // Fetch previous command. (up arrow)
@@ -42,13 +63,59 @@ namespace History
             // Reset history position
             void resetNavigation();
 
-            const std::vector<std::wstring> &entries() const;
+            // Number of positions, loaded and added, retired ones included
+            size_t size() const;
+
+            // Whether the entry at a position is current (not retired)
+            bool live(size_t index) const;
+
+            // Entry by position, oldest first
+            std::wstring at(size_t index) const;
+
+            // Entry by position as UTF-8, without copying; empty if retired; valid until the next push
+            std::string_view text(size_t index) const;
+
+            // How often the command was entered, and when last (FILETIME)
+            uint32_t uses(size_t index) const;
+            uint64_t time(size_t index) const;
+
+            // Frequency weighted by recency; higher ranks first
+            double frecency(size_t index) const;
+
+            // The recency weight alone; never grows towards older positions
+            double recency(size_t index) const;
+
+            // No live entry has more uses than this
+            uint32_t maxUses() const;
+
+            // Whether retired positions have piled up enough for compact()
+            bool compactDue() const;
+
+            // Renumber the live entries from 0 into memory of their own, releasing the mapped log
+            void compact();
+
+            // The entries loaded from disk
+            const Store &store() const;
 
         private:
-            std::vector<std::wstring> m_entries;
+            void add(std::string_view text, uint32_t uses, size_t index);
+            void trim();
+
+            Store m_store;
+
+            std::string m_added;                // this session's commands, UTF-8
+            std::vector<uint32_t> m_addedEnds;  // end of each in m_added
+            std::vector<uint64_t> m_addedTimes; // when each was entered
+
+            std::vector<uint32_t> m_uses;                 // per position; 0 once retired
+            std::unordered_map<uint64_t, uint32_t> m_index; // text hash -> newest position
+            size_t m_live = 0;                            // positions with uses > 0
+            uint32_t m_maxUses = 0;                       // bound on m_uses
+            size_t m_oldest = 0;                          // no live position before this
+            size_t m_capacity = SIZE_MAX;                 // set by load()
 
             // navigation cursor
             // size() == "the newest + 1" location
             size_t m_cursor = 0;
     };
-}
\ No newline at end of file
+}
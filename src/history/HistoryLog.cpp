@@ -0,0 +1,445 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistoryLog.cpp
+// PURPOSE: Append-only, crash-safe command history file.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <utility>
+
+#include "../platform/FileSystem.hpp"
+#include "HistoryLog.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Cuts a file at `end`. Fails with ERROR_USER_MAPPED_FILE while any process maps it.
+static bool truncateAt(HANDLE file, LONGLONG end)
+{
+    LARGE_INTEGER position{};
+    position.QuadPart = end;
+    return SetFilePointerEx(file, position, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+}
+
+// FUNCTIONS
+
+namespace History
+{
+    Log::Log(std::wstring path, size_t capacity)
+        : m_path(std::move(path)), m_capacity(capacity), m_compactAt(2 * capacity)
+    {
+        m_mutex = CreateMutexW(nullptr, FALSE, L"Local\\esh.history");
+        m_thread = std::thread([this]()
+                               { writer(); });
+    }
+
+    Log::~Log()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stop = true;
+        }
+
+        m_wake.notify_all();
+        m_thread.join();
+
+        if (m_mutex)
+            CloseHandle(m_mutex);
+    }
+
+    bool Log::exists() const
+    {
+        return GetFileAttributesW(m_path.c_str()) != INVALID_FILE_ATTRIBUTES;
+    }
+
+    Store Log::load()
+    {
+        Store store;
+
+        Platform::MutexLock lock(m_mutex);
+
+        if (!open(store))
+            return store;
+
+        removeOldGenerations();
+
+        if (store.size() >= m_compactAt || store.version() < Store::VERSION)
+        {
+            // Unmapped first; other instances may still map it, which replace() works around
+            store = Store();
+            compact();
+            open(store);
+        }
+
+        m_records.store(store.size());
+        return store;
+    }
+
+    /**
+     * @brief Maps the log, first cutting off a torn tail so new records follow the last good one.
+     *
+     * Only a file that is not a log at all is started over. One written by a
+     * newer esh, or one that cannot be mapped right now, is left alone and
+     * read as no history. The caller holds the named mutex.
+     */
+    bool Log::open(Store &store)
+    {
+        HANDLE hFile = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(hFile, &size) || size.QuadPart > UINT32_MAX)
+        {
+            CloseHandle(hFile); // beyond what the index addresses: leave it alone rather than cut it
+            return false;
+        }
+
+        uint32_t header[2] = {};
+        DWORD read = 0;
+        OVERLAPPED at{}; // offset 0
+
+        if (size.QuadPart < static_cast<LONGLONG>(Store::HEADER_SIZE))
+        {
+            truncateAt(hFile, 0); // a torn header: nothing was ever recorded
+            CloseHandle(hFile);
+            return false;
+        }
+
+        if (!ReadFile(hFile, header, sizeof(header), &read, &at) || read != sizeof(header))
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        if (header[0] != Store::MAGIC)
+        {
+            truncateAt(hFile, 0); // not a log: start over
+            CloseHandle(hFile);
+            return false;
+        }
+
+        if (header[1] > Store::VERSION || !store.open(hFile))
+        {
+            CloseHandle(hFile); // newer esh's log, or no mapping this time: keep it for later
+            return false;
+        }
+
+        if (store.validEnd() < static_cast<size_t>(size.QuadPart))
+        {
+            // A mapped file cannot be truncated, so unmap first. Another window may still map it;
+            // then the torn tail stays and commit() writes over it instead of after it.
+            const LONGLONG end = static_cast<LONGLONG>(store.validEnd());
+            store = Store();
+
+            truncateAt(hFile, end);
+            store.open(hFile);
+        }
+
+        CloseHandle(hFile);
+        return store.size() > 0;
+    }
+
+    void Log::retryCompaction()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_compactRequested = true;
+        }
+
+        m_wake.notify_all();
+    }
+
+    /**
+     * @brief Deletes logs that replace() renamed aside and that nobody maps any more.
+     *
+     * The caller holds the named mutex.
+     */
+    void Log::removeOldGenerations()
+    {
+        const size_t slash = m_path.find_last_of(L"\\/");
+        const std::wstring dir = slash == std::wstring::npos ? L"" : m_path.substr(0, slash + 1);
+
+        WIN32_FIND_DATAW ffd;
+        HANDLE hFind = FindFirstFileW((m_path + L".*.old").c_str(), &ffd);
+        if (hFind == INVALID_HANDLE_VALUE)
+            return;
+
+        do
+        {
+            DeleteFileW((dir + ffd.cFileName).c_str()); // still mapped by an instance: fails, tried again next time
+        } while (FindNextFileW(hFind, &ffd));
+
+        FindClose(hFind);
+    }
+
+    void Log::append(const std::wstring &command)
+    {
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_queue.push_back({(static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime, command});
+            ++m_appended;
+        }
+
+        m_wake.notify_all();
+    }
+
+    void Log::flush()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+
+        const uint64_t target = m_appended;
+        if (m_committed >= target)
+            return;
+
+        m_flushRequested = true;
+        m_wake.notify_all();
+
+        m_done.wait(guard, [&]()
+                    { return m_committed >= target; });
+    }
+
+    /// @brief Background thread: group-commits queued commands and compacts the log.
+    void Log::writer()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+
+        while (true)
+        {
+            m_wake.wait(guard, [this]()
+                        { return m_stop || !m_queue.empty() || m_compactRequested; });
+
+            if (m_stop && m_queue.empty())
+                return;
+
+            const bool retry = std::exchange(m_compactRequested, false);
+
+            // Let commands that arrive right after this one share its flush
+            if (!m_stop && !m_flushRequested && !m_queue.empty())
+                m_wake.wait_for(guard, std::chrono::milliseconds(COMMIT_DELAY), [this]()
+                                { return m_stop || m_flushRequested; });
+
+            std::vector<Entry> batch;
+            batch.swap(m_queue);
+
+            const uint64_t upto = m_appended;
+
+            guard.unlock();
+
+            if (retry)
+                m_compactDeferred = false;
+
+            if (!batch.empty() && commit(batch))
+                m_records.fetch_add(batch.size());
+
+            if (m_records.load() >= m_compactAt && !m_compactDeferred)
+            {
+                Platform::MutexLock lock(m_mutex);
+
+                // Failed despite the fallback in replace(): wait for retryCompaction() or the next start
+                m_compactDeferred = !compact();
+            }
+
+            guard.lock();
+
+            // Commands that could not be written are given up, so flush() never hangs
+            m_committed = upto;
+            m_flushRequested = false;
+            m_done.notify_all();
+        }
+    }
+
+    /// @brief Appends a batch of records with one write and one flush.
+    bool Log::commit(const std::vector<Entry> &batch)
+    {
+        Platform::MutexLock lock(m_mutex);
+
+        // Opened per batch, so a compaction in another instance never leaves us appending to a replaced file
+        HANDLE hFile = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size{};
+        GetFileSizeEx(hFile, &size);
+
+        size_t end = 0; // where the batch goes
+
+        if (size.QuadPart > 0)
+        {
+            // Records of this version must not follow an older header (its upgrade failed)
+            std::string header(Store::HEADER_SIZE, '\0');
+            DWORD read = 0;
+            if (!ReadFile(hFile, header.data(), static_cast<DWORD>(header.size()), &read, nullptr) ||
+                read != header.size() || header.compare(0, 8, Store::header(), 0, 8) != 0)
+            {
+                CloseHandle(hFile);
+                return false;
+            }
+
+            // Right after the last good record: a torn tail left by a crash (and still there
+            // because another window mapped the log) would hide every record written after it
+            Store store;
+            if (!store.open(hFile))
+            {
+                CloseHandle(hFile);
+                return false;
+            }
+
+            end = store.validEnd();
+        }
+
+        std::string data = size.QuadPart == 0 ? Store::header() : std::string();
+        for (const auto &entry : batch)
+            Store::encode(entry.time, entry.command, data);
+
+        OVERLAPPED at{};
+        at.Offset = static_cast<DWORD>(end);
+        at.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(end) >> 32);
+
+        DWORD written = 0;
+        bool ok = WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &written, &at) &&
+                  written == data.size();
+
+        // What is left of the torn tail goes if it can; a reader stops at it otherwise
+        if (ok && static_cast<LONGLONG>(end + data.size()) < size.QuadPart)
+            truncateAt(hFile, static_cast<LONGLONG>(end + data.size()));
+
+        ok = ok && FlushFileBuffers(hFile);
+
+        CloseHandle(hFile);
+        return ok;
+    }
+
+    /**
+     * @brief Rewrites the log with its newest `capacity` commands, including other instances' appends.
+     *
+     * Duplicates are merged into the newest record of each command, which
+     * keeps their total use count. The caller holds the named mutex.
+     */
+    bool Log::compact()
+    {
+        struct Kept
+        {
+            size_t record;
+            uint32_t uses;
+        };
+
+        std::string data = Store::header();
+        size_t records = 0;
+
+        {
+            HANDLE hFile = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                       nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (hFile == INVALID_HANDLE_VALUE)
+                return false;
+
+            Store store;
+            const bool ok = store.open(hFile);
+            CloseHandle(hFile);
+
+            if (!ok)
+                return false;
+
+            // Newest first: the first record of a command is the one kept; damaged ones are dropped
+            std::vector<Kept> kept;
+            std::unordered_map<uint64_t, size_t> seen; // text hash -> position in kept
+
+            for (size_t i = store.size(); i-- > 0;)
+            {
+                if (!store.intact(i))
+                    continue;
+
+                const std::string_view text = store.text(i);
+                const uint64_t hash = Store::hash(text);
+
+                auto it = seen.find(hash);
+                if (it != seen.end() && store.text(kept[it->second].record) == text)
+                {
+                    kept[it->second].uses += store.uses(i);
+                }
+                else if (kept.size() < m_capacity)
+                {
+                    seen.emplace(hash, kept.size());
+                    kept.push_back({i, store.uses(i)});
+                }
+            }
+
+            for (auto it = kept.rbegin(); it != kept.rend(); ++it)
+                Store::encode(store.time(it->record), it->uses, store.text(it->record), data);
+
+            records = kept.size();
+        } // unmapped before the file is replaced
+
+        if (!replace(data))
+            return false;
+
+        m_records.store(records);
+        return true;
+    }
+
+    bool Log::rewrite(const std::vector<Entry> &entries)
+    {
+        std::string data = Store::header();
+        for (const auto &entry : entries)
+            Store::encode(entry.time, entry.command, data);
+
+        Platform::MutexLock lock(m_mutex);
+        return replace(data);
+    }
+
+    /// @brief Writes `data` to a temp file, flushes it and renames it over the log.
+    bool Log::replace(const std::string &data)
+    {
+        const std::wstring temp = Platform::writeTempFile(m_path, data, true);
+        if (temp.empty())
+            return false;
+
+        bool ok = true;
+        if (!MoveFileExW(temp.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        {
+            // A log mapped by an esh window cannot be replaced, but it can be renamed:
+            // move it aside as an old generation, which its readers keep using until they unmap it
+            const std::wstring old = m_path + L"." + std::to_wstring(GetCurrentProcessId()) + L"." +
+                                     std::to_wstring(GetTickCount64()) + L".old";
+
+            ok = MoveFileExW(m_path.c_str(), old.c_str(), MOVEFILE_WRITE_THROUGH);
+            if (ok && !MoveFileExW(temp.c_str(), m_path.c_str(), MOVEFILE_WRITE_THROUGH))
+            {
+                MoveFileExW(old.c_str(), m_path.c_str(), MOVEFILE_WRITE_THROUGH);
+                ok = false;
+            }
+
+            if (ok)
+                DeleteFileW(old.c_str()); // fails while mapped; removeOldGenerations() finishes it
+        }
+
+        if (!ok)
+        {
+            DeleteFileW(temp.c_str());
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,142 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistoryLog.hpp
+// PURPOSE: Header file for 'src\history\HistoryLog.cpp'. Append-only, crash-safe command history file.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <windows.h>
+
+#include "HistoryStore.hpp"
+
+namespace History
+{
+    /**
+     * @class Log
+     * @brief Command history stored as an append-only log of checksummed records.
+     *
+     * The record format is described with Store, which reads the log. A
+     * record cut short or failing its checksum at the end of the file (a
+     * crash during a write) is cut off when the log is loaded.
+     *
+     * Appended commands are written by a background thread that gathers
+     * everything queued within COMMIT_DELAY into one write and one flush.
+     * Once the file holds twice `capacity` records, it is compacted: each
+     * command is kept once, at its newest record, carrying the use count
+     * of all its duplicates, and only the newest `capacity` commands
+     * remain. The result goes to a temp file that is renamed over the log.
+     * Other esh windows map the log, which Windows refuses to replace; the
+     * log is then renamed aside as an old generation first, which its
+     * readers keep until they unmap it, and which a later load deletes. A
+     * log in an older format is compacted when loaded. Writes and
+     * rewrites of all esh instances are serialized by a named mutex.
+     */
+    class Log
+    {
+    public:
+        static constexpr DWORD COMMIT_DELAY = 20; ///< Milliseconds to gather commands into one flush
+
+        struct Entry
+        {
+            uint64_t time = 0; ///< FILETIME when the command was entered; 0 if unknown
+            std::wstring command;
+        };
+
+        /**
+         * @param path Log file.
+         * @param capacity Distinct commands kept by a compaction.
+         */
+        Log(std::wstring path, size_t capacity);
+
+        /// @brief Writes what is still queued, then stops the writer thread.
+        ~Log();
+
+        Log(const Log &) = delete;
+        Log &operator=(const Log &) = delete;
+
+        /**
+         * @brief Maps the log, dropping a damaged tail and compacting it if due.
+         *
+         * @return Every record, oldest first; empty if the file does not exist.
+         */
+        Store load();
+
+        /**
+         * @brief Queues a command for the writer thread. Does not wait.
+         */
+        void append(const std::wstring &command);
+
+        /**
+         * @brief Waits until every queued command is on the disk.
+         *
+         * Costs one write at most, however long the history is.
+         */
+        void flush();
+
+        /**
+         * @brief Replaces the whole log with `entries` (temp file, flush, rename).
+         */
+        bool rewrite(const std::vector<Entry> &entries);
+
+        /**
+         * @brief Lets the writer retry a compaction that failed.
+         *
+         * Called once the history buffer no longer maps the log.
+         */
+        void retryCompaction();
+
+        /// @return Whether the log file exists.
+        bool exists() const;
+
+    private:
+        void writer();
+        bool open(Store &store);
+        bool commit(const std::vector<Entry> &batch);
+        bool compact();
+        bool replace(const std::string &data);
+        void removeOldGenerations();
+
+        std::wstring m_path;
+        size_t m_capacity;
+        size_t m_compactAt; ///< Records in the file that trigger a compaction
+        HANDLE m_mutex = nullptr; ///< Named; shared with other esh instances
+
+        std::mutex m_lock; ///< Guards the members below
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::vector<Entry> m_queue;
+        uint64_t m_appended = 0;  ///< Commands queued so far
+        uint64_t m_committed = 0; ///< Of those, how many were written
+        bool m_flushRequested = false;
+        bool m_compactRequested = false;
+        bool m_stop = false;
+
+        std::atomic<size_t> m_records{0}; ///< Records in the file
+        bool m_compactDeferred = false;   ///< Writer thread only: a compaction failed, wait for retryCompaction()
+        std::thread m_thread;
+    };
+}
@@ -19,6 +19,10 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <algorithm>
+#include <vector>
+
+#include "../headers/Unicode.hpp"
 #include "HistoryManager.hpp"
 #include "HistoryStorage.hpp"
 
@@ -27,19 +31,20 @@ using History::Manager;
 
 namespace History
 {
+    SearchIndex Manager::m_search([](size_t index)
+                                  { return m_buffer.text(index); });
 
     void Manager::initialize()
     {
-        // Load history from disk
-        const auto entries = HistoryStorage::load();
-
-        for (const auto &entry : entries)
-        {
-            m_buffer.push(entry);
-        }
+        // Map history from disk; entries are decoded when navigation reaches them
+        m_buffer.load(HistoryStorage::load(), HistoryStorage::capacity());
 
         // Cursor must point to "after last"
         m_buffer.resetNavigation();
+
+        m_search.build(m_buffer.store()); // in the background; the prompt does not wait
+
+        m_initialized = true;
     }
 
     void Manager::add(const std::wstring &command)
@@ -48,6 +53,26 @@ namespace History
             return;
 
         m_buffer.push(command);
+
+        if (m_buffer.compactDue())
+        {
+            // Retired duplicates piled up: renumber, then index the (at most capacity) commands left
+            m_search.clear();
+            m_buffer.compact();
+
+            if (m_initialized)
+                HistoryStorage::released(); // the log is no longer mapped; a deferred compaction can run
+
+            for (size_t i = 0; i < m_buffer.size(); ++i)
+                m_search.add(i, m_buffer.text(i));
+        }
+        else
+        {
+            m_search.add(m_buffer.size() - 1, m_buffer.text(m_buffer.size() - 1));
+        }
+
+        if (m_initialized)
+            HistoryStorage::append(command); // written in the background, survives a crash
     }
 
     std::optional<std::wstring> Manager::previous()
@@ -65,10 +90,79 @@ namespace History
         m_buffer.resetNavigation();
     }
 
+    std::optional<Manager::SearchResult> Manager::search(const std::wstring &query, size_t rank)
+    {
+        const std::string key = unicode::utf16_to_utf8(query);
+
+        struct Ranked
+        {
+            double score;
+            SearchIndex::Match match;
+        };
+
+        // Lower score, or on a tie the older command
+        auto worse = [](const Ranked &a, const Ranked &b)
+        {
+            return a.score != b.score ? a.score < b.score : a.match.index < b.match.index;
+        };
+
+        // Heap of the best rank + 1 so far, the worst of them on top
+        auto worstFirst = [&](const Ranked &a, const Ranked &b)
+        {
+            return worse(b, a);
+        };
+
+        std::vector<Ranked> best;
+        best.reserve(rank + 1);
+
+        // Newest first; each find() resumes below the last match
+        for (auto match = m_search.find(key, SIZE_MAX); match; match = m_search.find(key, match->index))
+        {
+            const double recency = m_buffer.recency(match->index);
+
+            // Older entries weigh no more than this one: once even the most used
+            // command could only tie with the worst kept, nothing older gets in
+            if (best.size() == rank + 1 && m_buffer.maxUses() * recency <= best.front().score)
+                break;
+
+            Ranked entry{m_buffer.uses(match->index) * recency, *match};
+
+            if (best.size() < rank + 1)
+            {
+                best.push_back(entry);
+                std::push_heap(best.begin(), best.end(), worstFirst);
+            }
+            else if (worse(best.front(), entry))
+            {
+                std::pop_heap(best.begin(), best.end(), worstFirst);
+                best.back() = entry;
+                std::push_heap(best.begin(), best.end(), worstFirst);
+            }
+        }
+
+        if (best.size() < rank + 1)
+            return std::nullopt;
+
+        const SearchIndex::Match &match = best.front().match; // the rank-th best
+
+        // Byte offsets in UTF-8 become character offsets in the command
+        const std::string_view text = m_buffer.text(match.index);
+
+        SearchResult result;
+        result.index = match.index;
+        result.command = unicode::utf8_to_utf16(std::string(text));
+        result.start = unicode::utf8_to_utf16(std::string(text.substr(0, match.start))).size();
+        result.length = unicode::utf8_to_utf16(std::string(text.substr(match.start, match.length))).size();
+        return result;
+    }
+
     void Manager::shutdown()
     {
-        // Persist RAM history to disk
-        HistoryStorage::save(m_buffer.entries());
+        if (!m_initialized)
+            return;
+
+        // Commands are on disk as they are entered; only the last few may still be queued
+        HistoryStorage::flush();
     }
 
 }
@@ -21,9 +21,12 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include "HistoryBuffer.hpp"
+#include "HistorySearch.hpp"
 
 namespace History
 {
@@ -32,11 +35,27 @@ namespace History
      *
      * Uses an internal Buffer to store commands and provides methods
      * to navigate previous/next entries, add new commands, and persist
-     * the history to disk.
+     * the history to disk. Each command is appended to the log as it is
+     * added, so a crash loses at most the last few milliseconds.
+     *
+     * A repeated command replaces its older entry, and at most
+     * HistoryStorage::capacity() commands (ESH_HISTSIZE) are kept, in
+     * memory and on disk.
      */
     class Manager
     {
     public:
+        /**
+         * @brief An entry found by search().
+         */
+        struct SearchResult
+        {
+            size_t index = 0;     ///< Position in the history
+            std::wstring command;
+            size_t start = 0;     ///< Matched characters in `command`
+            size_t length = 0;
+        };
+
         Manager() = default;
 
         /**
@@ -80,7 +99,25 @@ namespace History
         void resetNavigation();
 
         /**
-         * @brief Shuts down the manager and persists history to disk.
+         * @brief Finds a command containing `query` (Ctrl+R), ranked by frecency.
+         *
+         * Uses a trigram index kept up to date by add(), so each call
+         * touches only candidate entries. ASCII case is ignored. Matches
+         * rank by use count weighted by how recently they were used; ties
+         * go to the newer command. Only the best rank + 1 are kept while
+         * matches are walked newest first, and the walk stops once the
+         * recency weight leaves older matches no chance to reach them.
+         *
+         * @param query Text to look for.
+         * @param rank 0 for the best match, 1 for the next, and so on.
+         * @return The match, or empty if there are not that many.
+         */
+        std::optional<SearchResult> search(const std::wstring &query, size_t rank = 0);
+
+        /**
+         * @brief Shuts down the manager, waiting for queued history writes.
+         *
+         * Does nothing if history was never loaded (batch mode).
          */
         static void shutdown();
 
@@ -92,5 +129,7 @@ namespace History
     private:
         std::wstring m_historyFile;
         inline static Buffer m_buffer; /**< Internal buffer holding command history */
+        inline static bool m_initialized = false; /**< True once history was loaded from disk */
+        static SearchIndex m_search;              /**< Trigram index over m_buffer */
     };
 }
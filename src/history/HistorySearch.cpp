@@ -0,0 +1,193 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistorySearch.cpp
+// PURPOSE: Trigram index for incremental history search (Ctrl+R).
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+
+#include "HistorySearch.hpp"
+
+// HELPER FUNCTIONS
+
+static inline unsigned char fold(char c)
+{
+    const unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 'A' && u <= 'Z') ? static_cast<unsigned char>(u + ('a' - 'A')) : u;
+}
+
+static inline uint32_t trigram(const char *p)
+{
+    return (static_cast<uint32_t>(fold(p[0])) << 16) | (static_cast<uint32_t>(fold(p[1])) << 8) | fold(p[2]);
+}
+
+// FUNCTIONS
+
+namespace History
+{
+    SearchIndex::SearchIndex(TextFn text)
+        : m_text(std::move(text))
+    {
+    }
+
+    SearchIndex::~SearchIndex()
+    {
+        if (m_builder.joinable())
+            m_builder.join();
+    }
+
+    void SearchIndex::build(const Store &store)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_building = true;
+        }
+
+        m_builder = std::thread([this, &store]()
+                                {
+            Postings built;
+            for (size_t i = 0; i < store.size(); ++i)
+                indexText(built, static_cast<uint32_t>(i), store.text(i));
+
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            // Entries added meanwhile come after the loaded ones: put the loaded ones in front
+            for (auto &[key, ids] : built)
+            {
+                auto &live = m_postings[key];
+                if (live.empty())
+                    live = std::move(ids);
+                else
+                    live.insert(live.begin(), ids.begin(), ids.end());
+            }
+
+            // add() already counted up to the newest entry, which follows the loaded ones
+            m_count = std::max(m_count, store.size());
+            m_building = false;
+            m_built.notify_all(); });
+    }
+
+    void SearchIndex::add(size_t index, std::string_view text)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        indexText(m_postings, static_cast<uint32_t>(index), text);
+        m_count = std::max(m_count, index + 1);
+    }
+
+    void SearchIndex::clear()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_built.wait(guard, [this]()
+                     { return !m_building; });
+
+        m_postings.clear();
+        m_count = 0;
+    }
+
+    std::optional<SearchIndex::Match> SearchIndex::find(std::string_view query, size_t before)
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_built.wait(guard, [this]()
+                     { return !m_building; });
+
+        before = std::min(before, m_count);
+        if (query.empty() || before == 0)
+            return std::nullopt;
+
+        auto check = [&](size_t index) -> std::optional<Match>
+        {
+            auto start = contains(m_text(index), query);
+            if (!start)
+                return std::nullopt;
+
+            return Match{index, *start, query.size()};
+        };
+
+        if (query.size() < 3)
+        {
+            for (size_t i = before; i-- > 0;)
+            {
+                if (auto match = check(i))
+                    return match;
+            }
+            return std::nullopt;
+        }
+
+        // The posting lists of the query's trigrams, shortest first
+        std::vector<const std::vector<uint32_t> *> lists;
+        for (size_t i = 0; i + 3 <= query.size(); ++i)
+        {
+            auto it = m_postings.find(trigram(query.data() + i));
+            if (it == m_postings.end())
+                return std::nullopt; // some trigram occurs nowhere
+
+            if (std::find(lists.begin(), lists.end(), &it->second) == lists.end())
+                lists.push_back(&it->second);
+        }
+
+        std::sort(lists.begin(), lists.end(), [](auto *a, auto *b)
+                  { return a->size() < b->size(); });
+
+        // Walk the shortest list newest first; the others are probed by binary search
+        const auto &shortest = *lists.front();
+        auto end = std::lower_bound(shortest.begin(), shortest.end(), static_cast<uint32_t>(before));
+
+        for (auto it = end; it != shortest.begin();)
+        {
+            const uint32_t id = *--it;
+
+            bool everywhere = true;
+            for (size_t l = 1; l < lists.size() && everywhere; ++l)
+                everywhere = std::binary_search(lists[l]->begin(), lists[l]->end(), id);
+
+            if (!everywhere)
+                continue;
+
+            // Trigrams may match out of order; confirm the whole query
+            if (auto match = check(id))
+                return match;
+        }
+
+        return std::nullopt;
+    }
+
+    void SearchIndex::indexText(Postings &postings, uint32_t index, std::string_view text)
+    {
+        for (size_t i = 0; i + 3 <= text.size(); ++i)
+        {
+            auto &ids = postings[trigram(text.data() + i)];
+            if (ids.empty() || ids.back() != index) // once per entry
+                ids.push_back(index);
+        }
+    }
+
+    /// @return Byte offset of `query` in `text`, ignoring ASCII case.
+    std::optional<size_t> SearchIndex::contains(std::string_view text, std::string_view query)
+    {
+        if (query.size() > text.size())
+            return std::nullopt;
+
+        auto it = std::search(text.begin(), text.end(), query.begin(), query.end(), [](char a, char b)
+                              { return fold(a) == fold(b); });
+
+        if (it == text.end())
+            return std::nullopt;
+
+        return static_cast<size_t>(it - text.begin());
+    }
+}
@@ -0,0 +1,121 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistorySearch.hpp
+// PURPOSE: Header file for 'src\history\HistorySearch.cpp'. Trigram index for incremental history search (Ctrl+R).
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "HistoryStore.hpp"
+
+namespace History
+{
+    /**
+     * @class SearchIndex
+     * @brief Inverted index from trigrams to the history entries containing them.
+     *
+     * Entries are indexed as UTF-8 with ASCII letters folded to lower case,
+     * so searches ignore ASCII case. Each trigram maps to the ascending
+     * positions of the entries holding it. A query intersects the lists of
+     * its trigrams from the newest entry backwards, and the first candidate
+     * that really contains the query wins; the newest match ranks first.
+     * Queries shorter than a trigram scan entries newest first.
+     *
+     * The loaded history is indexed on a background thread; entries added
+     * meanwhile go straight into the index. Queries wait for the build.
+     * Entries whose text has become empty (retired duplicates) never match.
+     */
+    class SearchIndex
+    {
+    public:
+        /**
+         * @brief A match: entry position and the matched byte range of its UTF-8 text.
+         */
+        struct Match
+        {
+            size_t index = 0;
+            size_t start = 0;
+            size_t length = 0;
+        };
+
+        /// Returns the UTF-8 text of an entry; called on the querying thread only
+        using TextFn = std::function<std::string_view(size_t index)>;
+
+        explicit SearchIndex(TextFn text);
+        ~SearchIndex();
+
+        SearchIndex(const SearchIndex &) = delete;
+        SearchIndex &operator=(const SearchIndex &) = delete;
+
+        /**
+         * @brief Indexes the loaded history in the background.
+         *
+         * @param store Loaded entries; must stay alive and unchanged.
+         */
+        void build(const Store &store);
+
+        /**
+         * @brief Indexes an entry added after the loaded ones.
+         *
+         * @param index Its position; larger than any indexed before.
+         * @param text  Its UTF-8 text.
+         */
+        void add(size_t index, std::string_view text);
+
+        /**
+         * @brief Forgets every entry, once a running build has finished.
+         *
+         * For when positions are renumbered; the entries are then added again.
+         */
+        void clear();
+
+        /**
+         * @brief Finds the newest entry before `before` that contains `query`.
+         *
+         * @param query UTF-8 text, matched ignoring ASCII case.
+         * @param before Only entries at smaller positions are considered.
+         */
+        std::optional<Match> find(std::string_view query, size_t before);
+
+    private:
+        using Postings = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+        static void indexText(Postings &postings, uint32_t index, std::string_view text);
+        static std::optional<size_t> contains(std::string_view text, std::string_view query);
+
+        TextFn m_text;
+
+        std::mutex m_lock; ///< Guards the members below
+        std::condition_variable m_built;
+        Postings m_postings;
+        size_t m_count = 0; ///< Entries that can be searched: loaded (once built) plus added
+        bool m_building = false;
+
+        std::thread m_builder;
+    };
+}
@@ -19,102 +19,152 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <algorithm>
+#include <cwchar>
+
 #include <windows.h>
 
 #include "HistoryStorage.hpp"
+#include "HistoryLog.hpp"
 #include "../platform/AppDataPath.hpp"
 
+// HELPER FUNCTIONS
+
+/// @brief The history log, opened on first use (interactive sessions only).
+static History::Log &historyLog()
+{
+    static History::Log log((Platform::getBasePath() / L"history.log").wstring(), HistoryStorage::capacity());
+    return log;
+}
+
+/**
+ * @brief Reads 'history.txt', the format before the log: raw UTF-16 lines.
+ */
+static std::vector<std::wstring> loadLegacy(const std::wstring &path)
+{
+    std::vector<std::wstring> result;
+
+    HANDLE hFile = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+        return result;
+
+    DWORD size = GetFileSize(hFile, nullptr);
+    if (size == 0 || size == INVALID_FILE_SIZE)
+    {
+        CloseHandle(hFile);
+        return result;
+    }
+
+    std::wstring buffer(size / sizeof(wchar_t), L'\0');
+    DWORD read;
+    ReadFile(hFile, buffer.data(), size, &read, nullptr);
+    CloseHandle(hFile);
+
+    size_t start = 0;
+    size_t pos;
+    while ((pos = buffer.find(L'\n', start)) != std::wstring::npos)
+    {
+        if (pos > start)
+            result.push_back(buffer.substr(start, pos - start));
+        start = pos + 1;
+    }
+
+    return result;
+}
+
+// FUNCTIONS
+
 namespace HistoryStorage
 {
     /**
-     * @brief Loads the command history from disk.
-     *
-     * Reads the history file from the application's base path and
-     * returns each line as a separate entry in a vector.
-     *
-     * @return std::vector<std::wstring> Vector containing all history entries.
-     *         Returns an empty vector if the file does not exist or is empty.
+     * @brief Returns the history capacity, from ESH_HISTSIZE or the default.
      */
-    std::vector<std::wstring> load()
+    size_t capacity()
     {
-        std::vector<std::wstring> result;
+        static const size_t value = []() -> size_t
+        {
+            wchar_t buffer[32];
+            const DWORD length = GetEnvironmentVariableW(L"ESH_HISTSIZE", buffer, static_cast<DWORD>(std::size(buffer)));
+            if (length == 0 || length >= std::size(buffer))
+                return DEFAULT_CAPACITY;
 
-        std::wstring path = (Platform::getBasePath() / L"history.txt").wstring();
+            wchar_t *end = nullptr;
+            const unsigned long long size = wcstoull(buffer, &end, 10);
+            if (end == buffer || *end != L'\0' || size == 0)
+                return DEFAULT_CAPACITY;
 
-        HANDLE hFile = CreateFileW(
-            path.c_str(),
-            GENERIC_READ,
-            FILE_SHARE_READ,
-            nullptr,
-            OPEN_EXISTING,
-            FILE_ATTRIBUTE_NORMAL,
-            nullptr);
+            return static_cast<size_t>(std::min<unsigned long long>(size, MAX_CAPACITY));
+        }();
 
-        if (hFile == INVALID_HANDLE_VALUE)
-            return result;
+        return value;
+    }
 
-        DWORD size = GetFileSize(hFile, nullptr);
-        if (size == 0)
+    /**
+     * @brief Loads the command history from disk.
+     *
+     * On the first start after an update, the entries of 'history.txt'
+     * are moved into the log and the old file is deleted.
+     *
+     * @return History::Store Mapped history, oldest first.
+     *         Empty if there is no history yet.
+     */
+    History::Store load()
+    {
+        History::Log &log = historyLog();
+
+        if (!log.exists())
         {
-            CloseHandle(hFile);
-            return result;
-        }
+            const std::wstring legacy = (Platform::getBasePath() / L"history.txt").wstring();
+            const auto lines = loadLegacy(legacy);
 
-        std::wstring buffer(size / sizeof(wchar_t), L'\0');
-        DWORD read;
-        ReadFile(hFile, buffer.data(), size, &read, nullptr);
-        CloseHandle(hFile);
+            std::vector<History::Log::Entry> entries;
+            entries.reserve(lines.size());
+            for (const auto &line : lines)
+                entries.push_back({0, line});
 
-        size_t pos = 0;
-        while ((pos = buffer.find(L'\n')) != std::wstring::npos)
-        {
-            std::wstring line = buffer.substr(0, pos);
-            if (!line.empty())
-                result.push_back(line);
-            buffer.erase(0, pos + 1);
+            if (!entries.empty() && log.rewrite(entries))
+                DeleteFileW(legacy.c_str());
         }
 
-        return result;
+        return log.load();
     }
 
     /**
-     * @brief Saves the command history to disk.
+     * @brief Queues a command to be appended to the history log.
      *
-     * Writes all provided entries into the history file, one per line.
-     * Existing history is overwritten.
+     * Returns at once; a background thread writes it shortly after.
      *
-     * @param entries Vector of strings representing the history to save.
-     * 
+     * @param command Command line as entered.
      */
-    void save(const std::vector<std::wstring> &entries)
+    void append(const std::wstring &command)
     {
-        std::wstring path = (Platform::getBasePath() / L"history.txt").wstring();
-
-        HANDLE hFile = CreateFileW(
-            path.c_str(),
-            GENERIC_WRITE,
-            0,
-            nullptr,
-            CREATE_ALWAYS,
-            FILE_ATTRIBUTE_NORMAL,
-            nullptr);
-
-        if (hFile == INVALID_HANDLE_VALUE)
-            return;
+        historyLog().append(command);
+    }
 
-        for (const auto &e : entries)
-        {
-            DWORD written;
-            std::wstring line = e + L"\n";
-            WriteFile(
-                hFile,
-                line.c_str(),
-                static_cast<DWORD>(line.size() * sizeof(wchar_t)),
-                &written,
-                nullptr);
-        }
+    /**
+     * @brief Waits until every appended command is on disk.
+     *
+     * Only the commands not written yet are left to write, so this does
+     * not depend on the length of the history.
+     */
+    void flush()
+    {
+        historyLog().flush();
+    }
 
-        FlushFileBuffers(hFile);
-        CloseHandle(hFile);
+    /**
+     * @brief Lets a deferred compaction of the log run again.
+     */
+    void released()
+    {
+        historyLog().retryCompaction();
     }
-}
\ No newline at end of file
+}
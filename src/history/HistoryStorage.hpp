@@ -21,29 +21,55 @@ limitations under the License.
 
 // INCLUDE LIBRARIES
 
+#include <cstddef>
 #include <vector>
 #include <string>
 
+#include "HistoryStore.hpp"
+
 namespace HistoryStorage
 {
+    constexpr size_t DEFAULT_CAPACITY = 10000;  ///< Distinct commands kept unless ESH_HISTSIZE says otherwise
+    constexpr size_t MAX_CAPACITY = 1000000;    ///< Upper bound for ESH_HISTSIZE
+
+    /**
+     * @brief Number of distinct commands the history keeps.
+     *
+     * Read once from the ESH_HISTSIZE environment variable; a missing,
+     * zero or malformed value means DEFAULT_CAPACITY.
+     */
+    size_t capacity();
+
     /**
      * @brief Loads the shell command history from disk.
      *
-     * Reads the history file from the application's base path and
-     * returns each line as a separate entry in a vector.
+     * Maps 'history.log' (see History::Log) from the application's base
+     * path, migrating an old 'history.txt' into it first. Entries are
+     * decoded only when read.
      *
-     * @return std::vector<std::wstring> Vector of all history entries.
-     *         Returns an empty vector if the file does not exist or is empty.
+     * @return History::Store All history entries, oldest first.
+     *         Empty if there is no history yet.
      */
-    std::vector<std::wstring> load();
+    History::Store load();
 
     /**
-     * @brief Saves the shell command history to disk.
+     * @brief Appends one command to the history on disk.
+     *
+     * The command is written in the background; this does not block.
      *
-     * Writes all provided entries into the history file, one per line.
-     * Any existing history in the file is overwritten.
+     * @param command Command string to append.
+     */
+    void append(const std::wstring &command);
+
+    /**
+     * @brief Waits until every appended command has reached the disk.
+     */
+    void flush();
+
+    /**
+     * @brief Tells the log that the history buffer no longer maps it.
      *
-     * @param entries Vector of strings representing the history to save.
+     * A compaction that failed because of the mapping is tried again.
      */
-    void save(const std::vector<std::wstring> &entries);
-}
\ No newline at end of file
+    void released();
+}
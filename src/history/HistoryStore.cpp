@@ -0,0 +1,250 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistoryStore.cpp
+// PURPOSE: Memory-mapped, indexed view of the history log.
+
+// INCLUDE LIBRARIES
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "../headers/Unicode.hpp"
+#include "HistoryStore.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief CRC-32 (IEEE 802.3) lookup table.
+static constexpr std::array<uint32_t, 256> CRC_TABLE = []()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}();
+
+template <typename T>
+static T readAt(const char *data)
+{
+    T value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// FUNCTIONS
+
+namespace History
+{
+    Store::~Store()
+    {
+        close();
+    }
+
+    Store::Store(Store &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    Store &Store::operator=(Store &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_view = std::exchange(other.m_view, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_end = std::exchange(other.m_end, 0);
+            m_version = std::exchange(other.m_version, 0);
+            m_recordHeader = other.m_recordHeader;
+            m_offsets = std::move(other.m_offsets);
+            other.m_offsets.clear();
+        }
+
+        return *this;
+    }
+
+    void Store::close()
+    {
+        if (m_view)
+            UnmapViewOfFile(m_view);
+        if (m_mapping)
+            CloseHandle(m_mapping);
+
+        m_view = nullptr;
+        m_mapping = nullptr;
+        m_size = 0;
+        m_end = 0;
+        m_version = 0;
+        m_offsets.clear();
+    }
+
+    bool Store::open(HANDLE file)
+    {
+        close();
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(HEADER_SIZE) || size.QuadPart > UINT32_MAX)
+            return false;
+
+        m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping)
+            return false;
+
+        m_view = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_view)
+        {
+            close();
+            return false;
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        m_version = readAt<uint32_t>(m_view + 4);
+        if (readAt<uint32_t>(m_view) != MAGIC || m_version < 1 || m_version > VERSION)
+        {
+            close();
+            return false;
+        }
+
+        m_recordHeader = m_version == 1 ? RECORD_HEADER_V1 : RECORD_HEADER;
+
+        // Hop over the records; one entry per command in the index
+        m_offsets.reserve(m_size / 64);
+
+        size_t offset = HEADER_SIZE;
+        while (m_size - offset >= m_recordHeader)
+        {
+            const uint32_t length = readAt<uint32_t>(m_view + offset);
+            if (length > MAX_RECORD || m_size - offset - m_recordHeader < length)
+                break; // cut short
+
+            m_offsets.push_back(static_cast<uint32_t>(offset));
+            offset += m_recordHeader + length;
+        }
+
+        m_end = offset;
+
+        // Only the end of an append-only file can hold a torn write
+        size_t first = m_offsets.size();
+        while (first > 0 && m_offsets[first - 1] + TAIL_CHECK >= m_end)
+            --first;
+
+        for (size_t i = first; i < m_offsets.size(); ++i)
+        {
+            if (!intact(i))
+            {
+                m_end = m_offsets[i];
+                m_offsets.resize(i);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    std::wstring Store::command(size_t index) const
+    {
+        if (index >= m_offsets.size() || !intact(index))
+            return L"";
+
+        const char *record = m_view + m_offsets[index];
+        const uint32_t length = readAt<uint32_t>(record);
+        return unicode::utf8_to_utf16(std::string(record + m_recordHeader, length));
+    }
+
+    std::string_view Store::text(size_t index) const
+    {
+        const char *record = m_view + m_offsets[index];
+        return std::string_view(record + m_recordHeader, readAt<uint32_t>(record));
+    }
+
+    uint64_t Store::time(size_t index) const
+    {
+        if (index >= m_offsets.size())
+            return 0;
+
+        return readAt<uint64_t>(m_view + m_offsets[index] + 8);
+    }
+
+    uint32_t Store::uses(size_t index) const
+    {
+        if (index >= m_offsets.size() || m_version == 1)
+            return 1;
+
+        return readAt<uint32_t>(m_view + m_offsets[index] + 16);
+    }
+
+    bool Store::intact(size_t index) const
+    {
+        const char *record = m_view + m_offsets[index];
+        const uint32_t length = readAt<uint32_t>(record);
+
+        // The checksum covers the rest of the header and the text, which follow each other
+        return crc32(record + 8, m_recordHeader - 8 + length) == readAt<uint32_t>(record + 4);
+    }
+
+    void Store::encode(uint64_t time, const std::wstring &command, std::string &out)
+    {
+        encode(time, 1, unicode::utf16_to_utf8(command), out);
+    }
+
+    void Store::encode(uint64_t time, uint32_t uses, std::string_view text, std::string &out)
+    {
+        const uint32_t length = static_cast<uint32_t>(text.size());
+        uint32_t crc = crc32(reinterpret_cast<const char *>(&time), sizeof(time));
+        crc = crc32(reinterpret_cast<const char *>(&uses), sizeof(uses), crc);
+        crc = crc32(text.data(), text.size(), crc);
+
+        out.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        out.append(reinterpret_cast<const char *>(&crc), sizeof(crc));
+        out.append(reinterpret_cast<const char *>(&time), sizeof(time));
+        out.append(reinterpret_cast<const char *>(&uses), sizeof(uses));
+        out += text;
+    }
+
+    std::string Store::header()
+    {
+        std::string header(HEADER_SIZE, '\0');
+        const uint32_t magic = MAGIC;
+        const uint32_t version = VERSION;
+        memcpy(header.data(), &magic, sizeof(magic));
+        memcpy(header.data() + 4, &version, sizeof(version));
+        return header;
+    }
+
+    uint32_t Store::crc32(const char *data, size_t size, uint32_t crc)
+    {
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = CRC_TABLE[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    uint64_t Store::hash(std::string_view text)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : text)
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+        return hash;
+    }
+}
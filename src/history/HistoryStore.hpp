@@ -0,0 +1,136 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\history\HistoryStore.hpp
+// PURPOSE: Header file for 'src\history\HistoryStore.cpp'. Memory-mapped, indexed view of the history log.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <windows.h>
+
+namespace History
+{
+    /**
+     * @class Store
+     * @brief Read-only, memory-mapped view of a history log with an index of its records.
+     *
+     * The file starts with a 16-byte header (magic, version) followed by
+     * records:
+     *
+     *     [u32 length][u32 crc32][u64 FILETIME][u32 uses][length bytes of UTF-8]
+     *
+     * `uses` counts the times the command was entered: 1 when appended,
+     * the sum of its duplicates once compacted. The checksum covers
+     * everything after it. Version 1 records lack `uses` and are still
+     * read, so an old log can be compacted into the current format.
+     *
+     * Opening the store only hops from one record header to the next,
+     * keeping a 4-byte offset per record; texts are decoded when asked for.
+     * Torn writes can only be at the end of an append-only file, so only
+     * records in the last TAIL_CHECK bytes are checked on open; the index
+     * stops at the first bad one. Other records are checked when decoded.
+     *
+     * The mapped pages are the file's own cache pages, so the store costs
+     * about the file's size plus the index.
+     */
+    class Store
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x4C485345; ///< "ESHL"
+        static constexpr uint32_t VERSION = 2;
+
+        static constexpr size_t HEADER_SIZE = 16;
+        static constexpr size_t RECORD_HEADER = 20;         ///< length, crc32, time, uses
+        static constexpr size_t RECORD_HEADER_V1 = 16;      ///< length, crc32, time
+        static constexpr uint32_t MAX_RECORD = 1024 * 1024;  ///< Longer lengths mean a damaged file
+        static constexpr size_t TAIL_CHECK = 64 * 1024;      ///< Bytes at the end checked on open
+
+        Store() = default;
+        ~Store();
+
+        Store(Store &&other) noexcept;
+        Store &operator=(Store &&other) noexcept;
+
+        Store(const Store &) = delete;
+        Store &operator=(const Store &) = delete;
+
+        /**
+         * @brief Maps a log file and indexes its records.
+         *
+         * The handle may be closed afterwards.
+         *
+         * @param file Log file, opened for reading.
+         * @return false if the file is not a log, is empty or cannot be mapped.
+         */
+        bool open(HANDLE file);
+
+        /// @return Number of indexed records.
+        size_t size() const { return m_offsets.size(); }
+
+        /// @return Format version of the mapped file.
+        uint32_t version() const { return m_version; }
+
+        /// @return File offset just past the last good record.
+        size_t validEnd() const { return m_end; }
+
+        /// @return The command of record `index`; empty if the record is damaged.
+        std::wstring command(size_t index) const;
+
+        /// @return The UTF-8 text of record `index` as stored, unchecked.
+        std::string_view text(size_t index) const;
+
+        /// @return When record `index` was entered (FILETIME); 0 if unknown.
+        uint64_t time(size_t index) const;
+
+        /// @return How often the command of record `index` was entered.
+        uint32_t uses(size_t index) const;
+
+        /// @return Whether the record's checksum matches.
+        bool intact(size_t index) const;
+
+        /// @brief Appends a record of a newly entered command to `out`.
+        static void encode(uint64_t time, const std::wstring &command, std::string &out);
+
+        /// @brief Appends a record with its UTF-8 text and use count to `out`.
+        static void encode(uint64_t time, uint32_t uses, std::string_view text, std::string &out);
+
+        /// @return The file header.
+        static std::string header();
+
+        static uint32_t crc32(const char *data, size_t size, uint32_t crc = 0);
+
+        /// @return 64-bit FNV-1a hash of a command's text, to find its duplicates.
+        static uint64_t hash(std::string_view text);
+
+    private:
+        void close();
+
+        HANDLE m_mapping = nullptr;
+        const char *m_view = nullptr;
+        size_t m_size = 0;
+        size_t m_end = 0;
+        uint32_t m_version = 0;
+        size_t m_recordHeader = RECORD_HEADER;
+        std::vector<uint32_t> m_offsets; ///< Files are far below 4 GiB; open() refuses bigger ones
+    };
+}
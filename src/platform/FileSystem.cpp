@@ -0,0 +1,97 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\platform\FileSystem.cpp
+// PURPOSE: File system helpers shared by esh's state files.
+
+// INCLUDE LIBRARIES
+
+#include <windows.h>
+
+#include "FileSystem.hpp"
+
+namespace Platform
+{
+    std::wstring fullPath(const std::wstring &path)
+    {
+        std::wstring input = path.empty() ? L"." : path;
+
+        DWORD length = GetFullPathNameW(input.c_str(), 0, nullptr, nullptr);
+        if (length == 0)
+            return input;
+
+        std::wstring full(length, L'\0');
+        length = GetFullPathNameW(input.c_str(), length, full.data(), nullptr);
+        full.resize(length);
+
+        while (full.size() > 3 && (full.back() == L'\\' || full.back() == L'/'))
+            full.pop_back();
+
+        return full;
+    }
+
+    std::wstring writeTempFile(const std::wstring &path, const std::string &data, bool durable)
+    {
+        const std::wstring temp = path + L"." + std::to_wstring(GetCurrentProcessId()) + L".tmp";
+
+        HANDLE hFile = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return L"";
+
+        DWORD written = 0;
+        const bool ok = WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+                        written == data.size() && (!durable || FlushFileBuffers(hFile));
+
+        CloseHandle(hFile);
+
+        if (!ok)
+        {
+            DeleteFileW(temp.c_str());
+            return L"";
+        }
+
+        return temp;
+    }
+
+    bool replaceFile(const std::wstring &path, const std::string &data, bool durable)
+    {
+        const std::wstring temp = writeTempFile(path, data, durable);
+        if (temp.empty())
+            return false;
+
+        const DWORD flags = MOVEFILE_REPLACE_EXISTING | (durable ? MOVEFILE_WRITE_THROUGH : 0);
+        if (!MoveFileExW(temp.c_str(), path.c_str(), flags))
+        {
+            DeleteFileW(temp.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    MutexLock::MutexLock(HANDLE mutex)
+        : m_mutex(mutex)
+    {
+        if (m_mutex)
+            WaitForSingleObject(m_mutex, INFINITE);
+    }
+
+    MutexLock::~MutexLock()
+    {
+        if (m_mutex)
+            ReleaseMutex(m_mutex);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\platform\FileSystem.hpp
+// PURPOSE: Header file for 'src\platform\FileSystem.cpp'. File system helpers shared by esh's state files.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <string>
+
+#include <windows.h>
+
+namespace Platform
+{
+    // Absolute form of a path, without trailing separators (except after a drive)
+    std::wstring fullPath(const std::wstring &path);
+
+    // Writes `data` to a temp file next to `path`; returns its name, or empty on failure.
+    // With `durable` the data is flushed to the disk before returning.
+    std::wstring writeTempFile(const std::wstring &path, const std::string &data, bool durable);
+
+    // Replaces `path` whole with `data`: temp file, optional flush, rename.
+    // Readers see either the old or the new contents, never half of one.
+    bool replaceFile(const std::wstring &path, const std::string &data, bool durable);
+
+    /**
+     * @brief Owns a mutex (named ones are shared by esh instances) while in scope.
+     *
+     * An abandoned mutex still hands over ownership; the files it guards
+     * are replaced whole or checked when read. A null handle locks nothing.
+     */
+    class MutexLock
+    {
+    public:
+        explicit MutexLock(HANDLE mutex);
+        ~MutexLock();
+
+        MutexLock(const MutexLock &) = delete;
+        MutexLock &operator=(const MutexLock &) = delete;
+
+    private:
+        HANDLE m_mutex;
+    };
+}
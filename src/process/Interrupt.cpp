@@ -0,0 +1,67 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\process\Interrupt.cpp
+// PURPOSE: Turns Ctrl+C into an event built-ins can wait on.
+
+// INCLUDE LIBRARIES
+
+#include <windows.h>
+
+#include "Interrupt.hpp"
+
+// HELPER FUNCTIONS
+
+static HANDLE g_interrupt = nullptr;
+
+/// @brief Runs on a console thread created by the system.
+static BOOL WINAPI onConsoleCtrl(DWORD type)
+{
+    if (type != CTRL_C_EVENT && type != CTRL_BREAK_EVENT)
+        return FALSE; // closing the window or logging off still ends esh
+
+    SetEvent(g_interrupt);
+    return TRUE;
+}
+
+// FUNCTIONS
+
+namespace Process
+{
+    void Interrupt::install()
+    {
+        if (g_interrupt)
+            return;
+
+        g_interrupt = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (g_interrupt && !SetConsoleCtrlHandler(onConsoleCtrl, TRUE))
+        {
+            CloseHandle(g_interrupt);
+            g_interrupt = nullptr;
+        }
+    }
+
+    HANDLE Interrupt::event()
+    {
+        return g_interrupt;
+    }
+
+    void Interrupt::reset()
+    {
+        if (g_interrupt)
+            ResetEvent(g_interrupt);
+    }
+}
@@ -0,0 +1,51 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\process\Interrupt.hpp
+// PURPOSE: Header file for 'src\process\Interrupt.cpp'. Turns Ctrl+C into an event built-ins can wait on.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <windows.h>
+
+namespace Process
+{
+    /**
+     * @class Interrupt
+     * @brief Ctrl+C and Ctrl+Break for built-ins, which run inside esh itself.
+     *
+     * Once installed, the keys no longer end esh; they signal a manual-reset
+     * event instead. Built-ins that can run indefinitely (such as 'tail -f')
+     * wait on it through Context::interrupt and return when it is set.
+     * Pipeline stages wait on their job's own event instead, which
+     * JobTable::waitForeground sets only while the job is in the foreground.
+     * External programs still receive Ctrl+C from the console themselves.
+     */
+    class Interrupt
+    {
+    public:
+        /// @brief Installs the console handler. Interactive sessions only.
+        static void install();
+
+        /// @return The event, or nullptr if the handler is not installed.
+        static HANDLE event();
+
+        /// @brief Forgets a Ctrl+C pressed before the next command starts.
+        static void reset();
+    };
+}
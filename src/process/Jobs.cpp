@@ -0,0 +1,452 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\process\Jobs.cpp
+// PURPOSE: Tracks foreground and background jobs, reaps their processes and handles Ctrl+Z.
+
+// INCLUDE LIBRARIES
+
+#include <algorithm>
+#include <iostream>
+
+#include <windows.h>
+#include <tlhelp32.h>
+#include <psapi.h>
+
+#include "Jobs.hpp"
+#include "Interrupt.hpp"
+#include "../headers/Console.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Thread-pool callback for a finished process. Runs on the wait thread.
+static VOID CALLBACK onProcessExit(PVOID param, BOOLEAN /*timedOut*/)
+{
+    static_cast<Process::Job *>(param)->finishOne();
+}
+
+/**
+ * @brief Consumes a pending Ctrl+Z from the console input buffer.
+ *
+ * On Windows Ctrl+Z is a key press, not a signal, so the shell peeks at
+ * the input the foreground job shares with it. Events in front of the
+ * Ctrl+Z are consumed with it.
+ *
+ * @return true if Ctrl+Z was pressed.
+ */
+static bool consumeCtrlZ(HANDLE input)
+{
+    INPUT_RECORD records[64];
+    DWORD count = 0;
+
+    if (!PeekConsoleInputW(input, records, 64, &count))
+        return false;
+
+    for (DWORD i = 0; i < count; ++i)
+    {
+        const auto &r = records[i];
+        if (r.EventType != KEY_EVENT || !r.Event.KeyEvent.bKeyDown)
+            continue;
+
+        const bool ctrl = r.Event.KeyEvent.dwControlKeyState & (LEFT_CTRL_PRESSED | RIGHT_CTRL_PRESSED);
+        if (ctrl && r.Event.KeyEvent.wVirtualKeyCode == 'Z')
+        {
+            DWORD read = 0;
+            ReadConsoleInputW(input, records, i + 1, &read);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief Converts a FILETIME interval (100 ns units) to microseconds.
+static uint64_t toMicros(const FILETIME &ft)
+{
+    return ((static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime) / 10;
+}
+
+/// @brief Returns the state as shown by 'jobs'.
+static const wchar_t *stateName(Process::JobState state)
+{
+    switch (state)
+    {
+    case Process::JobState::RUNNING:
+        return L"Running";
+    case Process::JobState::STOPPED:
+        return L"Stopped";
+    default:
+        return L"Done";
+    }
+}
+
+// FUNCTIONS
+
+namespace Process
+{
+    Job::~Job()
+    {
+        for (HANDLE process : processes)
+            CloseHandle(process);
+
+        if (doneEvent)
+            CloseHandle(doneEvent);
+
+        if (interrupt)
+            CloseHandle(interrupt);
+
+        if (jobObject)
+            CloseHandle(jobObject);
+    }
+
+    JobState Job::state() const
+    {
+        // Not `remaining == 0`: the last stage still has to set doneEvent after that,
+        // and a job reported done may be removed and freed at once
+        if (WaitForSingleObject(doneEvent, 0) == WAIT_OBJECT_0)
+            return JobState::DONE;
+
+        return stopped ? JobState::STOPPED : JobState::RUNNING;
+    }
+
+    void Job::finishOne()
+    {
+        // The shell treats the job as done (and may free it) only once doneEvent is set,
+        // so SetEvent must be the last access to the job
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            SetEvent(doneEvent);
+    }
+
+    DWORD Job::exitCode() const
+    {
+        if (stages.empty())
+            return 0;
+
+        const StageStatus &last = stages.back();
+
+        DWORD code = last.exitCode;
+        if (last.process)
+            GetExitCodeProcess(last.process, &code);
+
+        return code;
+    }
+
+    void Job::collectStatus()
+    {
+        for (StageStatus &stage : stages)
+        {
+            if (!stage.process)
+                continue;
+
+            GetExitCodeProcess(stage.process, &stage.exitCode);
+
+            FILETIME creation, exit, kernel, user;
+            if (GetProcessTimes(stage.process, &creation, &exit, &kernel, &user))
+            {
+                stage.wallMicros = toMicros(exit) - toMicros(creation);
+                stage.userMicros = toMicros(user);
+                stage.kernelMicros = toMicros(kernel);
+            }
+
+            PROCESS_MEMORY_COUNTERS memory{};
+            memory.cb = sizeof(memory);
+            if (GetProcessMemoryInfo(stage.process, &memory, sizeof(memory)))
+                stage.peakRss = memory.PeakWorkingSetSize;
+        }
+    }
+
+    JobTable &JobTable::instance()
+    {
+        static JobTable table;
+        return table;
+    }
+
+    Job &JobTable::create(std::wstring command, bool background)
+    {
+        auto job = std::make_shared<Job>();
+
+        job->id = m_jobs.empty() ? 1 : m_jobs.back()->id + 1;
+        job->command = std::move(command);
+        job->jobObject = CreateJobObjectW(nullptr, nullptr);
+        job->doneEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        job->interrupt = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        job->remaining.store(1, std::memory_order_relaxed); // launch guard, see launched()
+        job->background = background;
+
+        m_jobs.push_back(std::move(job));
+        return *m_jobs.back();
+    }
+
+    void JobTable::attachProcess(Job &job, HANDLE process)
+    {
+        // Join the job before the first instruction runs, so children it starts are tracked too
+        if (job.jobObject)
+            AssignProcessToJobObject(job.jobObject, process);
+
+        job.processes.push_back(process);
+        job.remaining.fetch_add(1, std::memory_order_relaxed);
+
+        // Reap from the thread pool; no thread per process
+        HANDLE wait = nullptr;
+        if (RegisterWaitForSingleObject(&wait, process, onProcessExit, &job, INFINITE,
+                                        WT_EXECUTEONLYONCE | WT_EXECUTEINWAITTHREAD))
+            job.waits.push_back(wait);
+    }
+
+    void JobTable::attachStage(Job &job)
+    {
+        job.remaining.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void JobTable::launched(Job &job)
+    {
+        job.finishOne();
+    }
+
+    Job *JobTable::find(int id)
+    {
+        if (m_jobs.empty())
+            return nullptr;
+
+        if (id == 0)
+            return m_jobs.back().get();
+
+        for (auto &job : m_jobs)
+        {
+            if (job->id == id)
+                return job.get();
+        }
+
+        return nullptr;
+    }
+
+    std::vector<int> JobTable::ids() const
+    {
+        std::vector<int> result;
+        result.reserve(m_jobs.size());
+
+        for (const auto &job : m_jobs)
+            result.push_back(job->id);
+
+        return result;
+    }
+
+    DWORD JobTable::waitForeground(Job &job)
+    {
+        job.background = false;
+
+        HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+        const bool watchInput = GetFileType(input) == FILE_TYPE_CHAR;
+
+        // Ctrl+C is delivered to every process on the console: let it reach the job, not esh.
+        // A job of built-ins only is stopped through the interrupt event instead.
+        const bool ignoreCtrlC = !job.processes.empty();
+        if (ignoreCtrlC)
+            SetConsoleCtrlHandler(nullptr, TRUE);
+
+        // Ctrl+C reaches esh's handler as the shell-wide event; only the foreground job gets it
+        HANDLE ctrlC = job.interrupt ? Interrupt::event() : nullptr;
+
+        std::vector<HANDLE> handles{job.doneEvent};
+        if (ctrlC)
+            handles.push_back(ctrlC);
+        const DWORD inputIndex = static_cast<DWORD>(handles.size());
+        if (watchInput)
+            handles.push_back(input);
+
+        bool stopped = false;
+
+        while (true)
+        {
+            DWORD r = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+
+            if (ctrlC && r == WAIT_OBJECT_0 + 1)
+            {
+                ResetEvent(ctrlC);
+                SetEvent(job.interrupt);
+                continue;
+            }
+
+            if (!watchInput || r != WAIT_OBJECT_0 + inputIndex)
+                break; // done (or the wait failed)
+
+            if (!job.processes.empty() && consumeCtrlZ(input)) // built-in stages are threads of esh itself
+            {
+                stopped = setStopped(job, true);
+                if (stopped)
+                    break;
+            }
+
+            // Other input belongs to the job; give it a moment to read it
+            WaitForSingleObject(job.doneEvent, 50);
+        }
+
+        if (ignoreCtrlC)
+            SetConsoleCtrlHandler(nullptr, FALSE);
+
+        if (stopped)
+        {
+            job.background = true;
+            console::writeln(L"");
+            print(job);
+            return STOPPED_STATUS;
+        }
+
+        return wait(job);
+    }
+
+    DWORD JobTable::wait(Job &job)
+    {
+        if (job.stopped)
+            setStopped(job, false); // a stopped job would never finish
+
+        WaitForSingleObject(job.doneEvent, INFINITE);
+
+        job.collectStatus();
+
+        DWORD code = job.exitCode();
+        recordStatus(std::move(job.stages));
+        remove(job.id);
+        return code;
+    }
+
+    bool JobTable::setStopped(Job &job, bool stopped)
+    {
+        // Everything in the job object, including processes the pipeline started itself
+        std::vector<DWORD> pids;
+        {
+            std::vector<BYTE> buffer(sizeof(JOBOBJECT_BASIC_PROCESS_ID_LIST) + 1024 * sizeof(ULONG_PTR));
+            auto *list = reinterpret_cast<JOBOBJECT_BASIC_PROCESS_ID_LIST *>(buffer.data());
+
+            if (!QueryInformationJobObject(job.jobObject, JobObjectBasicProcessIdList,
+                                           list, static_cast<DWORD>(buffer.size()), nullptr))
+                return false;
+
+            for (DWORD i = 0; i < list->NumberOfProcessIdsInList; ++i)
+                pids.push_back(static_cast<DWORD>(list->ProcessIdList[i]));
+        }
+
+        std::sort(pids.begin(), pids.end());
+
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE)
+            return false;
+
+        THREADENTRY32 entry;
+        entry.dwSize = sizeof(THREADENTRY32);
+
+        if (Thread32First(snapshot, &entry))
+        {
+            do
+            {
+                if (!std::binary_search(pids.begin(), pids.end(), entry.th32OwnerProcessID))
+                    continue;
+
+                HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME, FALSE, entry.th32ThreadID);
+                if (!thread)
+                    continue;
+
+                stopped ? SuspendThread(thread) : ResumeThread(thread);
+                CloseHandle(thread);
+
+            } while (Thread32Next(snapshot, &entry));
+        }
+
+        CloseHandle(snapshot);
+
+        job.stopped = stopped;
+        return true;
+    }
+
+    void JobTable::recordStatus(std::vector<StageStatus> stages)
+    {
+        std::wstring codes;
+
+        for (const StageStatus &stage : stages)
+        {
+            if (!codes.empty())
+                codes += L' ';
+
+            codes += std::to_wstring(stage.exitCode);
+        }
+
+        SetEnvironmentVariableW(L"PIPESTATUS", codes.c_str());
+
+        m_lastStatus = std::move(stages);
+
+        for (StageStatus &stage : m_lastStatus)
+            stage.process = nullptr; // the handles are closed with the job
+    }
+
+    void JobTable::reportFinished()
+    {
+        for (int id : ids())
+        {
+            Job *job = find(id);
+            if (job->background && job->state() == JobState::DONE)
+            {
+                print(*job);
+                remove(id);
+            }
+        }
+    }
+
+    void JobTable::list()
+    {
+        for (int id : ids())
+        {
+            Job *job = find(id);
+            print(*job);
+
+            if (job->state() == JobState::DONE)
+                remove(id);
+        }
+    }
+
+    void JobTable::print(const Job &job)
+    {
+        const JobState state = job.state();
+        const wchar_t *current = m_jobs.back()->id == job.id ? L"+" : L" ";
+
+        std::wstring line = L"[" + std::to_wstring(job.id) + L"]" + current + L"  " + stateName(state);
+
+        if (state == JobState::DONE && job.exitCode() != 0)
+            line += L"(" + std::to_wstring(job.exitCode()) + L")";
+
+        line.resize(std::max<size_t>(line.size() + 1, 20), L' ');
+        line += job.command;
+
+        console::writeln(line);
+    }
+
+    void JobTable::remove(int id)
+    {
+        auto it = std::find_if(m_jobs.begin(), m_jobs.end(), [id](const std::shared_ptr<Job> &job)
+                               { return job->id == id; });
+
+        if (it == m_jobs.end())
+            return;
+
+        Job &job = **it;
+
+        // Blocks until a callback still running on the wait thread has returned
+        for (HANDLE wait : job.waits)
+            UnregisterWaitEx(wait, INVALID_HANDLE_VALUE);
+
+        // The handles are closed with the job, once no stage thread holds it any more
+        m_jobs.erase(it);
+    }
+}
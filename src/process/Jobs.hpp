@@ -0,0 +1,219 @@
+/*
+Copyright 2026 Habil Eren Türker
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// FILE: src\process\Jobs.hpp
+// PURPOSE: Header file for 'src\process\Jobs.cpp'. Tracks foreground and background jobs.
+
+#pragma once
+
+// INCLUDE LIBRARIES
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+namespace Process
+{
+    enum class JobState : uint8_t
+    {
+        RUNNING,
+        STOPPED,
+        DONE
+    };
+
+    /**
+     * @brief Completion record of one pipeline stage.
+     */
+    struct StageStatus
+    {
+        std::wstring command;
+        bool builtin = false;
+        bool started = false;      ///< false if the program could not be started
+        DWORD exitCode = 0;
+        uint64_t wallMicros = 0;   ///< Wall-clock time from start to exit
+        uint64_t userMicros = 0;   ///< User-mode CPU time
+        uint64_t kernelMicros = 0; ///< Kernel-mode CPU time
+        uint64_t peakRss = 0;      ///< Peak working set in bytes (0 for built-ins, which share esh's)
+        HANDLE process = nullptr;  ///< External stages only; owned by Job::processes
+    };
+
+    /**
+     * @brief One pipeline started by the shell.
+     *
+     * All processes of the pipeline (and anything they start) live in one
+     * Windows job object, which plays the role of a process group. Built-in
+     * stages run as threads inside esh and are counted alongside them.
+     * Process exits are collected by thread-pool waits
+     * (RegisterWaitForSingleObject); those and the stage threads only touch
+     * `remaining`, their own slot of `stages` and `doneEvent`. Everything else is owned
+     * by the shell thread.
+     *
+     * Stage threads are detached and hold a reference of their own, so the job
+     * and its handles outlive its removal from the table until the last one returns.
+     */
+    struct Job : std::enable_shared_from_this<Job>
+    {
+        int id = 0;
+        std::wstring command;
+
+        HANDLE jobObject = nullptr;
+        HANDLE doneEvent = nullptr; ///< Manual-reset, set when every process exited
+        HANDLE interrupt = nullptr; ///< Manual-reset; Ctrl+C for the job's built-in stages, set only while it is in the foreground
+        std::vector<HANDLE> processes;
+        std::vector<HANDLE> waits; ///< Registered waits, one per process
+
+        std::atomic<size_t> remaining{0};    ///< Processes and built-in stages still running
+        std::vector<StageStatus> stages;     ///< Sized before any stage starts; each stage thread fills its own slot
+        bool stopped = false;
+        bool background = false;
+
+        ~Job();
+
+        JobState state() const;
+
+        /**
+         * @brief Marks one process or built-in stage as finished. Thread-safe.
+         */
+        void finishOne();
+
+        /**
+         * @brief Fills exit status, times and peak memory of the external stages.
+         *
+         * Only valid once the job is done.
+         */
+        void collectStatus();
+
+        /**
+         * @brief Exit status of the last stage of the pipeline.
+         */
+        DWORD exitCode() const;
+    };
+
+    /**
+     * @brief The shell's job table. Only used from the shell thread.
+     */
+    class JobTable
+    {
+    public:
+        /** Exit status reported for a job stopped with Ctrl+Z (128 + SIGTSTP). */
+        static constexpr DWORD STOPPED_STATUS = 148;
+
+        static JobTable &instance();
+
+        /**
+         * @brief Registers a pipeline that is about to be started.
+         *
+         * The job counts as running until launched() is called, so stages
+         * finishing while later ones are still being started cannot
+         * complete it early.
+         *
+         * @param command    Text shown by 'jobs'.
+         * @param background True if started with '&'.
+         * @return The new job.
+         */
+        Job &create(std::wstring command, bool background);
+
+        /**
+         * @brief Adds a process (created suspended) to the job and starts reaping it.
+         *
+         * @param process Process handle (ownership taken).
+         */
+        void attachProcess(Job &job, HANDLE process);
+
+        /**
+         * @brief Counts a built-in stage thread; the thread calls Job::finishOne() when done.
+         */
+        void attachStage(Job &job);
+
+        /**
+         * @brief Ends the launch phase started by create().
+         */
+        void launched(Job &job);
+
+        /**
+         * @brief Finds a job by id.
+         *
+         * @param id Job id, or 0 for the current (most recent) job.
+         * @return The job, or nullptr.
+         */
+        Job *find(int id);
+
+        /**
+         * @brief Waits for a job in the foreground.
+         *
+         * Ctrl+C goes to the job only: external processes get it from the
+         * console, built-in stages through the job's interrupt event. Ctrl+Z
+         * stops the job and returns to the prompt. A finished job is removed
+         * from the table.
+         *
+         * @return Exit status of the job, or STOPPED_STATUS.
+         */
+        DWORD waitForeground(Job &job);
+
+        /**
+         * @brief Waits until a job finishes, without Ctrl+Z handling, and removes it.
+         *
+         * @return Exit status of the job.
+         */
+        DWORD wait(Job &job);
+
+        /**
+         * @brief Suspends or resumes every thread of every process in the job.
+         */
+        bool setStopped(Job &job, bool stopped);
+
+        /**
+         * @brief Prints "[id]  Done  command" for finished background jobs and drops them.
+         */
+        void reportFinished();
+
+        /**
+         * @brief Prints every job with its state. Finished jobs are dropped afterwards.
+         */
+        void list();
+
+        /**
+         * @brief Ids of all jobs, oldest first.
+         */
+        std::vector<int> ids() const;
+
+        /**
+         * @brief Stores the stage records of the last waited-for pipeline.
+         *
+         * Also exported as PIPESTATUS (space-separated exit codes) to the
+         * environment of programs started afterwards.
+         */
+        void recordStatus(std::vector<StageStatus> stages);
+
+        /**
+         * @brief Stage records of the last waited-for pipeline (see 'pipestat').
+         */
+        const std::vector<StageStatus> &lastStatus() const { return m_lastStatus; }
+
+    private:
+        JobTable() = default;
+
+        void remove(int id);
+        void print(const Job &job);
+
+        std::vector<std::shared_ptr<Job>> m_jobs;
+        std::vector<StageStatus> m_lastStatus;
+    };
+}
@@ -23,6 +23,8 @@ limitations under the License.
 #include <string>
 #include <cstdint>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <unordered_map>
 
 #include <windows.h>
@@ -33,12 +35,101 @@ limitations under the License.
 #include "../headers/Result.hpp"
 #include "../headers/Commands.hpp"
 #include "../headers/Console.hpp"
+#include "../execution/Execution.hpp"
 #include "ProcessCommands.hpp"
+#include "Jobs.hpp"
+
+// HELPER FUNCTIONS
+
+/// @brief Formats microseconds as "0.412ms" or "3.205s".
+static std::wstring formatMicros(uint64_t micros)
+{
+    wchar_t buffer[32];
+
+    if (micros < 1000000)
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%.3fms", micros / 1000.0);
+    else
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%.3fs", micros / 1000000.0);
+
+    return buffer;
+}
+
+/// @brief Formats a byte count as "812K" or "14.2M".
+static std::wstring formatBytes(uint64_t bytes)
+{
+    wchar_t buffer[32];
+
+    if (bytes < 1024 * 1024)
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%lluK", static_cast<unsigned long long>(bytes / 1024));
+    else
+        swprintf(buffer, sizeof(buffer) / sizeof(wchar_t), L"%.1fM", bytes / (1024.0 * 1024.0));
+
+    return buffer;
+}
+
+/**
+ * @brief Name of a job-control built-in, for error messages.
+ *
+ * @return The name, or nullptr if `cmd` does not use the job table.
+ */
+static const wchar_t *jobControlName(CommandType cmd)
+{
+    switch (cmd)
+    {
+    case CommandType::JOBS:
+        return L"jobs";
+    case CommandType::FG:
+        return L"fg";
+    case CommandType::BG:
+        return L"bg";
+    case CommandType::WAIT:
+        return L"wait";
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Resolves a job spec ("%2", "2", "%+", "%%" or nothing) to a job.
+ *
+ * @param args    Command arguments; only the first one is used.
+ * @param command Command name used in error messages.
+ * @return The job, or an error if no such job exists.
+ */
+static Result<Process::Job *> findJob(const std::vector<std::wstring> &args, const std::wstring &command)
+{
+    int id = 0;
+
+    if (!args.empty())
+    {
+        std::wstring spec = args[0];
+        if (!spec.empty() && spec[0] == L'%')
+            spec.erase(0, 1);
+
+        if (!spec.empty() && spec != L"+" && spec != L"%")
+        {
+            try
+            {
+                id = std::stoi(spec);
+            }
+            catch (const std::exception &)
+            {
+                return {nullptr, {0, command + L": " + args[0] + L": no such job"}};
+            }
+        }
+    }
+
+    Process::Job *job = Process::JobTable::instance().find(id);
+    if (!job)
+        return {nullptr, {0, command + L": " + (args.empty() ? L"current" : args[0]) + L": no such job"}};
+
+    return {job, {}};
+}
 
 namespace Process
 {
 
-    void ProcessCommands::execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args)
+    void ProcessCommands::execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args, Execution::Executor::Context &ctx)
     {
         // Helper lambda to print boolean command results
         auto printBoolResult =
@@ -57,6 +148,18 @@ namespace Process
             console::reset();
         };
 
+        // The job table is the shell thread's; a pipeline or background stage runs on a thread of its own job
+        if (const wchar_t *name = jobControlName(cmd); name && ctx.pipelineEnabled)
+        {
+            console::setColor(ConsoleColor::Red);
+            std::wcerr << name << L": job control is only available at the prompt, not in a pipeline or background job" << std::endl;
+            console::reset();
+            ctx.exitCode = 1;
+            return;
+        }
+
+        BoolResult res{true, {}};
+
         switch (cmd)
         {
         case CommandType::PS:
@@ -74,12 +177,40 @@ namespace Process
             executeKILL(std::stoul(args[0]));
             break;
 
+        case CommandType::JOBS:
+            executeJOBS();
+            break;
+
+        case CommandType::FG:
+            res = executeFG(args, ctx);
+            break;
+
+        case CommandType::BG:
+            res = executeBG(args);
+            break;
+
+        case CommandType::WAIT:
+            res = executeWAIT(args, ctx);
+            break;
+
+        case CommandType::PIPESTAT:
+            res = executePIPESTAT(ctx);
+            break;
+
         default:
             console::setColor(ConsoleColor::Red);
             std::wcerr << L"ShellCommands: Unsupported command" << std::endl;
             console::reset();
             break;
         }
+
+        if (!res.ok())
+        {
+            console::setColor(ConsoleColor::Red);
+            std::wcerr << res.error.message << std::endl;
+            console::reset();
+            ctx.exitCode = 1;
+        }
     }
 
     BoolResult ProcessCommands::executePS()
@@ -166,4 +297,101 @@ namespace Process
         return {true, {}};
     }
 
+    BoolResult ProcessCommands::executeJOBS()
+    {
+        JobTable::instance().list();
+        return {true, {}};
+    }
+
+    BoolResult ProcessCommands::executeFG(const std::vector<std::wstring> &args, Execution::Executor::Context &ctx)
+    {
+        auto found = findJob(args, L"fg");
+        if (!found.ok())
+            return {false, found.error};
+
+        Job &job = *found.value;
+        console::writeln(job.command);
+
+        if (job.stopped && !JobTable::instance().setStopped(job, false))
+            return {false, makeLastError(L"fg")};
+
+        ctx.exitCode = JobTable::instance().waitForeground(job);
+        return {true, {}};
+    }
+
+    BoolResult ProcessCommands::executeBG(const std::vector<std::wstring> &args)
+    {
+        auto found = findJob(args, L"bg");
+        if (!found.ok())
+            return {false, found.error};
+
+        Job &job = *found.value;
+
+        if (job.state() != JobState::STOPPED)
+            return {false, {0, L"bg: job " + std::to_wstring(job.id) + L" is not stopped"}};
+
+        if (!JobTable::instance().setStopped(job, false))
+            return {false, makeLastError(L"bg")};
+
+        job.background = true;
+        console::writeln(L"[" + std::to_wstring(job.id) + L"] " + job.command);
+        return {true, {}};
+    }
+
+    BoolResult ProcessCommands::executeWAIT(const std::vector<std::wstring> &args, Execution::Executor::Context &ctx)
+    {
+        auto &jobs = JobTable::instance();
+
+        if (!args.empty())
+        {
+            auto found = findJob(args, L"wait");
+            if (!found.ok())
+                return {false, found.error};
+
+            ctx.exitCode = jobs.wait(*found.value);
+            return {true, {}};
+        }
+
+        // No argument: wait for every job; the status is the last one's
+        for (int id : jobs.ids())
+        {
+            if (Job *job = jobs.find(id))
+                ctx.exitCode = jobs.wait(*job);
+        }
+
+        return {true, {}};
+    }
+
+    BoolResult ProcessCommands::executePIPESTAT(Execution::Executor::Context &ctx)
+    {
+        const auto &stages = JobTable::instance().lastStatus();
+
+        std::wostringstream out;
+        out << std::left
+            << std::setw(7) << L"STAGE" << std::setw(8) << L"STATUS"
+            << std::setw(12) << L"WALL" << std::setw(12) << L"USER" << std::setw(12) << L"SYS"
+            << std::setw(12) << L"MAX RSS" << L"COMMAND\n";
+
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            const StageStatus &stage = stages[i];
+
+            out << std::setw(7) << i + 1;
+
+            if (stage.started)
+                out << std::setw(8) << stage.exitCode
+                    << std::setw(12) << formatMicros(stage.wallMicros)
+                    << std::setw(12) << formatMicros(stage.userMicros)
+                    << std::setw(12) << formatMicros(stage.kernelMicros)
+                    << std::setw(12) << (stage.builtin ? std::wstring(L"-") : formatBytes(stage.peakRss));
+            else
+                out << std::setw(8) << stage.exitCode << std::setw(48) << L"(not started)";
+
+            out << stage.command << L"\n";
+        }
+
+        Execution::Executor::writeOutput(ctx, out.str());
+        return {true, {}};
+    }
+
 }
@@ -29,6 +29,7 @@ limitations under the License.
 
 #include "../headers/Result.hpp"
 #include "../headers/Commands.hpp"
+#include "../execution/Execution.hpp"
 
 namespace Process
 {
@@ -36,11 +37,16 @@ namespace Process
     class ProcessCommands
     {
     public:
-        static void execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args);
+        static void execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args, Execution::Executor::Context &ctx);
 
     private:
         // COMMAND IMPLEMENTATION           Function prototypes
         static BoolResult executePS();
         static BoolResult executeKILL(DWORD pid);
+        static BoolResult executeJOBS();
+        static BoolResult executeFG(const std::vector<std::wstring> &args, Execution::Executor::Context &ctx);
+        static BoolResult executeBG(const std::vector<std::wstring> &args);
+        static BoolResult executeWAIT(const std::vector<std::wstring> &args, Execution::Executor::Context &ctx);
+        static BoolResult executePIPESTAT(Execution::Executor::Context &ctx);
     };
 }
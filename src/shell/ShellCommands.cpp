@@ -31,12 +31,14 @@ limitations under the License.
 #include "../headers/Helper.hpp"
 #include "../system/SystemCommands.hpp"
 #include "../history/HistoryManager.hpp"
+#include "../headers/PlanCache.hpp"
+#include "../file/MetadataCache.hpp"
 #include "ShellCommands.hpp"
 
 namespace ShellCmds
 { // DO NOT CHANGE the name to 'Shell'. It creates errors (because I tried before).
 
-    void ShellCommands::execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args)
+    void ShellCommands::execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args, Execution::Executor::Context &ctx)
     {
         switch (cmd)
         {
@@ -52,7 +54,12 @@ namespace ShellCmds
 
         case CommandType::ECHO:
             // Echo the args
-            executeECHO(args);
+            executeECHO(args, !(flags & FLAG_COUNT), ctx); // '-n' is parsed as a flag
+            break;
+
+        case CommandType::CACHE:
+            // Show cache statistics
+            executeCACHE(ctx);
             break;
 
         default:
@@ -112,13 +119,8 @@ namespace ShellCmds
     }
 
     // ECHO COMMAND
-    BoolResult ShellCommands::executeECHO(const std::vector<std::wstring> &args)
+    BoolResult ShellCommands::executeECHO(const std::vector<std::wstring> &args, bool newline, Execution::Executor::Context &ctx)
     {
-        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-        if (hOut == INVALID_HANDLE_VALUE)
-            return {false, makeLastError(L"echo")};
-
-        bool newline = true;
         size_t start = 0;
 
         if (!args.empty() && args[0] == L"-n")
@@ -142,13 +144,7 @@ namespace ShellCmds
         if (newline)
             output += L"\n";
 
-        DWORD written;
-        WriteConsoleW(
-            hOut,
-            output.c_str(),
-            static_cast<DWORD>(output.size()),
-            &written,
-            nullptr);
+        Execution::Executor::writeOutput(ctx, output);
 
         return {true, {}};
     }
@@ -162,4 +158,33 @@ namespace ShellCmds
 
         exit(EXIT_SUCCESS);
     }
-}
\ No newline at end of file
+
+    // CACHE COMMAND
+    BoolResult ShellCommands::executeCACHE(Execution::Executor::Context &ctx)
+    {
+        auto hitRate = [](uint64_t hits, uint64_t misses)
+        {
+            uint64_t total = hits + misses;
+            return total ? static_cast<int>(hits * 100 / total) : 0;
+        };
+
+        const auto plans = PlanCache::instance().stats();
+        const auto metadata = FileIO::MetadataCache::instance().stats();
+
+        std::wostringstream out;
+
+        out << L"plans:    " << plans.hits << L" hits, " << plans.misses << L" misses ("
+            << hitRate(plans.hits, plans.misses) << L"%), "
+            << plans.size << L"/" << plans.capacity << L" lines\n";
+
+        out << L"metadata: " << metadata.hits << L" hits, " << metadata.misses << L" misses ("
+            << hitRate(metadata.hits, metadata.misses) << L"%), "
+            << metadata.invalidations << L" invalidated, " << metadata.evictions << L" evicted, "
+            << metadata.expirations << L" expired, "
+            << metadata.directories << L" directories, "
+            << metadata.bytes / 1024 << L"/" << metadata.budget / 1024 << L" KB\n";
+
+        Execution::Executor::writeOutput(ctx, out.str());
+        return {true, {}};
+    }
+}
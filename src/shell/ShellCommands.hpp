@@ -27,6 +27,7 @@ limitations under the License.
 
 #include "../headers/Result.hpp"
 #include "../headers/Commands.hpp"
+#include "../execution/Execution.hpp"
 
 /**
  * @brief Namespace containing shell-related commands.
@@ -40,6 +41,7 @@ namespace ShellCmds
      *  - EXIT: Exit the shell.
      *  - CLEAR: Clear the shell console.
      *  - ECHO: Print arguments to the console.
+     *  - CACHE: Show hit/miss statistics of the shell's caches.
      */
     class ShellCommands
     {
@@ -50,8 +52,9 @@ namespace ShellCmds
          * @param cmd Command type to execute (EXIT, CLEAR, ECHO).
          * @param flags Bitwise flags affecting command behavior.
          * @param args Vector of string arguments for the command.
+         * @param ctx Execution context (output may be a pipeline stage).
          */
-        static void execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args);
+        static void execute(CommandType cmd, uint16_t flags, const std::vector<std::wstring> &args, Execution::Executor::Context &ctx);
 
     private:
         /**
@@ -68,8 +71,18 @@ namespace ShellCmds
          * @brief Prints the provided arguments to the console.
          * 
          * @param args Vector of strings to print.
+         * @param newline false for 'echo -n'.
+         * @param ctx Execution context.
          * @return BoolResult indicating success or failure.
          */
-        static BoolResult executeECHO(const std::vector<std::wstring> &args);
+        static BoolResult executeECHO(const std::vector<std::wstring> &args, bool newline, Execution::Executor::Context &ctx);
+
+        /**
+         * @brief Prints hit/miss statistics of the plan cache and the metadata cache.
+         *
+         * @param ctx Execution context.
+         * @return BoolResult indicating success or failure.
+         */
+        static BoolResult executeCACHE(Execution::Executor::Context &ctx);
     };
 }